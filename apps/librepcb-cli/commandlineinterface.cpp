@@ -81,6 +81,12 @@ int CommandLineInterface::execute() noexcept {
                  "overwritten. Supported file extensions: %1"))
           .arg("pdf"),
       tr("file"));
+  QCommandLineOption skipUnchangedSchematicsOption(
+      "skip-unchanged-schematics",
+      tr("Skip exporting schematics if no page has changed since the last "
+         "export to the same file. If any page has changed, all pages are "
+         "exported. The page fingerprints are stored in a file next to the "
+         "exported file."));
   QCommandLineOption exportPcbFabricationDataOption(
       "export-pcb-fabrication-data",
       tr("Export PCB fabrication data (Gerber/Excellon) according the "
@@ -114,6 +120,7 @@ int CommandLineInterface::execute() noexcept {
                                  tr("Path to project file (*.lpp)."));
     parser.addOption(ercOption);
     parser.addOption(exportSchematicsOption);
+    parser.addOption(skipUnchangedSchematicsOption);
     parser.addOption(exportPcbFabricationDataOption);
     parser.addOption(boardOption);
     parser.addOption(saveOption);
@@ -168,9 +175,10 @@ int CommandLineInterface::execute() noexcept {
       return 1;
     }
     cmdSuccess = openProject(
-        positionalArgs.value(0),                // project filepath
-        parser.isSet(ercOption),                // run ERC
-        parser.values(exportSchematicsOption),  // export schematics
+        positionalArgs.value(0),                      // project filepath
+        parser.isSet(ercOption),                      // run ERC
+        parser.values(exportSchematicsOption),        // export schematics
+        parser.isSet(skipUnchangedSchematicsOption),  // skip if unchanged
         parser.isSet(
             exportPcbFabricationDataOption),  // export PCB fabrication data
         parser.values(boardOption),           // boards
@@ -194,6 +202,7 @@ int CommandLineInterface::execute() noexcept {
 
 bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
                                        const QStringList& exportSchematicsFiles,
+                                       bool skipUnchangedSchematics,
                                        bool exportPcbFabricationData,
                                        const QStringList& boards,
                                        bool               save) const noexcept {
@@ -252,8 +261,13 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
                   str, FilePath::ReplaceSpaces | FilePath::KeepCase);
             });
         FilePath destPath(QFileInfo(destPathStr).absoluteFilePath());
-        project.exportSchematicsAsPdf(destPath);  // can throw
-        print(QString("  => '%1'").arg(prettyPath(destPath, destPathStr)));
+        int pageCount = project.exportSchematicsAsPdf(
+            destPath, skipUnchangedSchematics);  // can throw
+        if (pageCount > 0) {
+          print(QString("  => '%1'").arg(prettyPath(destPath, destPathStr)));
+        } else {
+          print("  " % tr("No page has changed, file not written."));
+        }
       } else {
         printErr("  " %
                  QString(tr("ERROR: Unknown extension '%1'.")).arg(suffix));
@@ -286,7 +300,7 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
       foreach (const Board* board, boardList) {
         print("  " % QString(tr("Board '%1':")).arg(*board->getName()));
         BoardGerberExport grbExport(*board);
-        grbExport.exportAllLayers();  // can throw
+        grbExport.exportAllLayers(true);  // can throw
         foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
           filesCounter[fp]++;
           if (filesCounter[fp] > 1) filesOverwritten = true;
@@ -57,6 +57,7 @@ public:
 private:  // Methods
   bool           openProject(const QString& projectFile, bool runErc,
                              const QStringList& exportSchematicsFiles,
+                             bool skipUnchangedSchematics,
                              bool exportPcbFabricationData, const QStringList& boards,
                              bool save) const noexcept;
   static QString prettyPath(const FilePath& path,
@@ -0,0 +1,283 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "drillpathoptimizer.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/// Number of nearest neighbours considered as 2-opt candidates for each hit
+static constexpr int sNeighbourCount = 8;
+
+/// Upper limit of 2-opt passes over the whole path
+static constexpr int sMaxTwoOptPasses = 50;
+
+/// Minimum improvement [nm] of a 2-opt move to avoid endless rounding loops
+static constexpr qreal sMinGain = 0.5;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+DrillPathOptimizer::DrillPathOptimizer(const QVector<Point>& hits,
+                                       const Point&          start) noexcept
+  : mNodes(), mBounds(), mCellSize(1), mColumns(1), mRows(1) {
+  mNodes.reserve(hits.count() + 1);
+  mNodes.append(QPointF(start.getX().toNm(), start.getY().toNm()));
+  foreach (const Point& hit, hits) {
+    mNodes.append(QPointF(hit.getX().toNm(), hit.getY().toNm()));
+  }
+}
+
+DrillPathOptimizer::~DrillPathOptimizer() noexcept {
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QVector<Point> DrillPathOptimizer::optimize(const QVector<Point>& hits,
+                                            const Point& start) noexcept {
+  if (hits.count() < 2) {
+    return hits;
+  }
+
+  DrillPathOptimizer optimizer(hits, start);
+  optimizer.buildGrid();
+  optimizer.buildNearestNeighbourPath();
+  optimizer.buildGrid();  // the nearest neighbour search consumed the grid
+  optimizer.improveWithTwoOpt();
+
+  QVector<Point> result;
+  result.reserve(hits.count());
+  for (int i = 1; i < optimizer.mPath.count(); ++i) {
+    result.append(hits.at(optimizer.mPath.at(i) - 1));
+  }
+  if (calcTravelDistance(result, start) < calcTravelDistance(hits, start)) {
+    return result;
+  } else {
+    return hits;  // the original order is already good enough
+  }
+}
+
+qreal DrillPathOptimizer::calcTravelDistance(const QVector<Point>& hits,
+                                             const Point& start) noexcept {
+  qreal distance = 0;
+  Point previous = start;
+  foreach (const Point& hit, hits) {
+    qreal dx = qreal(hit.getX().toNm()) - qreal(previous.getX().toNm());
+    qreal dy = qreal(hit.getY().toNm()) - qreal(previous.getY().toNm());
+    distance += qSqrt(dx * dx + dy * dy);
+    previous = hit;
+  }
+  return distance;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void DrillPathOptimizer::buildGrid() noexcept {
+  // the start node is not part of the grid since it is never searched for
+  int   count  = mNodes.count() - 1;
+  qreal left   = mNodes.at(1).x();
+  qreal right  = left;
+  qreal top    = mNodes.at(1).y();
+  qreal bottom = top;
+  for (int i = 2; i < mNodes.count(); ++i) {
+    left   = qMin(left, mNodes.at(i).x());
+    right  = qMax(right, mNodes.at(i).x());
+    top    = qMin(top, mNodes.at(i).y());
+    bottom = qMax(bottom, mNodes.at(i).y());
+  }
+  mBounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+
+  // about two hits per cell, but limit the number of cells if all hits are
+  // located on a line
+  qreal width  = mBounds.width();
+  qreal height = mBounds.height();
+  qreal area   = qMax(width, qreal(1)) * qMax(height, qreal(1));
+  mCellSize    = qMax(qSqrt(2 * area / count), qMax(width, height) / count);
+  mCellSize    = qMax(mCellSize, qreal(1));
+  mColumns     = qFloor(width / mCellSize) + 1;
+  mRows        = qFloor(height / mCellSize) + 1;
+
+  mCells.clear();
+  mCells.resize(mColumns * mRows);
+  for (int i = 1; i < mNodes.count(); ++i) {
+    QPoint cell = getCell(mNodes.at(i));
+    mCells[getCellIndex(cell.x(), cell.y())].append(i);
+  }
+}
+
+int DrillPathOptimizer::getCellIndex(int column, int row) const noexcept {
+  return (row * mColumns) + column;
+}
+
+QPoint DrillPathOptimizer::getCell(const QPointF& pos) const noexcept {
+  // positions outside the grid (e.g. the start node) are clamped to it
+  qreal column = (pos.x() - mBounds.left()) / mCellSize;
+  qreal row    = (pos.y() - mBounds.top()) / mCellSize;
+  return QPoint(qFloor(qBound(qreal(0), column, qreal(mColumns - 1))),
+                qFloor(qBound(qreal(0), row, qreal(mRows - 1))));
+}
+
+QVector<int> DrillPathOptimizer::findNearest(const QPointF& pos, int count,
+                                             int exclude) const noexcept {
+  QVector<QPair<qreal, int>> nearest;  // squared distance, node; sorted
+  QPoint center    = getCell(pos);
+  int    maxRadius = qMax(mColumns, mRows);
+  for (int radius = 0; radius <= maxRadius; ++radius) {
+    // visit only the cells on the ring with the given radius
+    for (int row = center.y() - radius; row <= center.y() + radius; ++row) {
+      if ((row < 0) || (row >= mRows)) continue;
+      bool outerRow = (qAbs(row - center.y()) == radius);
+      int  step     = outerRow ? 1 : (2 * radius);
+      for (int column = center.x() - radius; column <= center.x() + radius;
+           column += step) {
+        if ((column < 0) || (column >= mColumns)) continue;
+        foreach (int node, mCells.at(getCellIndex(column, row))) {
+          if (node == exclude) continue;
+          QPointF diff     = mNodes.at(node) - pos;
+          qreal   distance = (diff.x() * diff.x()) + (diff.y() * diff.y());
+          if ((nearest.count() < count) || (distance < nearest.last().first)) {
+            QPair<qreal, int> item(distance, node);
+            nearest.insert(
+                std::upper_bound(nearest.begin(), nearest.end(), item), item);
+            if (nearest.count() > count) {
+              nearest.removeLast();
+            }
+          }
+        }
+      }
+    }
+    // all nodes on the following rings are at least this far away
+    qreal minDistance = radius * mCellSize;
+    if ((nearest.count() == count) &&
+        (nearest.last().first <= minDistance * minDistance)) {
+      break;
+    }
+  }
+
+  QVector<int> nodes;
+  nodes.reserve(nearest.count());
+  foreach (const auto& item, nearest) {
+    nodes.append(item.second);
+  }
+  return nodes;
+}
+
+void DrillPathOptimizer::buildNearestNeighbourPath() noexcept {
+  mPath.clear();
+  mPath.reserve(mNodes.count());
+  mPath.append(0);
+  while (mPath.count() < mNodes.count()) {
+    QVector<int> nearest = findNearest(mNodes.at(mPath.last()), 1, -1);
+    Q_ASSERT(nearest.count() == 1);
+    int    node = nearest.first();
+    QPoint cell = getCell(mNodes.at(node));
+    mCells[getCellIndex(cell.x(), cell.y())].removeOne(node);
+    mPath.append(node);
+  }
+}
+
+void DrillPathOptimizer::improveWithTwoOpt() noexcept {
+  int count = mNodes.count();
+  mPathIndices.resize(count);
+  for (int i = 0; i < count; ++i) {
+    mPathIndices[mPath.at(i)] = i;
+  }
+  QVector<QVector<int>> neighbours(count);
+  for (int node = 0; node < count; ++node) {
+    neighbours[node] = findNearest(mNodes.at(node), sNeighbourCount, node);
+  }
+
+  // Only moves creating an edge to one of the nearest neighbours are checked.
+  // Since the neighbours are sorted by distance, the search for a node can be
+  // aborted as soon as the new edge would be longer than the removed one.
+  bool improved = true;
+  for (int pass = 0; improved && (pass < sMaxTwoOptPasses); ++pass) {
+    improved = false;
+    for (int i = 0; i < count - 1; ++i) {
+      // path "a b .. c d" --> "a c .. b d" (d may not exist)
+      int a = mPath.at(i);
+      foreach (int c, neighbours.at(a)) {
+        int   b   = mPath.at(i + 1);
+        qreal dab = getDistance(a, b);
+        qreal dac = getDistance(a, c);
+        if (dac >= dab) break;
+        int j = mPathIndices.at(c);
+        if (j <= i + 1) continue;
+        qreal delta = dac - dab;
+        if (j + 1 < count) {
+          int d = mPath.at(j + 1);
+          delta += getDistance(b, d) - getDistance(c, d);
+        }
+        if (delta < -sMinGain) {
+          reversePath(i + 1, j);
+          improved = true;
+        }
+      }
+
+      // path "e c .. a b" --> "e a .. c b" (the start node never moves)
+      int b = mPath.at(i + 1);
+      foreach (int c, neighbours.at(b)) {
+        a         = mPath.at(i);
+        qreal dab = getDistance(a, b);
+        qreal dbc = getDistance(b, c);
+        if (dbc >= dab) break;
+        int j = mPathIndices.at(c);
+        if ((j < 1) || (j >= i)) continue;
+        int   e     = mPath.at(j - 1);
+        qreal delta = getDistance(e, a) + dbc - getDistance(e, c) - dab;
+        if (delta < -sMinGain) {
+          reversePath(j, i);
+          improved = true;
+        }
+      }
+    }
+  }
+}
+
+void DrillPathOptimizer::reversePath(int first, int last) noexcept {
+  std::reverse(mPath.begin() + first, mPath.begin() + last + 1);
+  for (int i = first; i <= last; ++i) {
+    mPathIndices[mPath.at(i)] = i;
+  }
+}
+
+qreal DrillPathOptimizer::getDistance(int node1, int node2) const noexcept {
+  QPointF diff = mNodes.at(node1) - mNodes.at(node2);
+  return qSqrt((diff.x() * diff.x()) + (diff.y() * diff.y()));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_DRILLPATHOPTIMIZER_H
+#define LIBREPCB_DRILLPATHOPTIMIZER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../units/point.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class DrillPathOptimizer
+ ******************************************************************************/
+
+/**
+ * @brief Reorders drill hits to reduce the travel distance of the drill head
+ *
+ * The path starts at a given position (e.g. the last hit of the previous
+ * tool) and is first built with a nearest neighbour heuristic, then improved
+ * with 2-opt moves until no more improvement is found. Both steps only look at
+ * spatially close hits which are found with a uniform grid, so even large hit
+ * counts are processed quickly.
+ *
+ * The result is never longer than the original order.
+ */
+class DrillPathOptimizer final {
+public:
+  // Constructors / Destructor
+  DrillPathOptimizer()                                = delete;
+  DrillPathOptimizer(const DrillPathOptimizer& other) = delete;
+  ~DrillPathOptimizer() noexcept;
+
+  // Static Methods
+  static QVector<Point> optimize(const QVector<Point>& hits,
+                                 const Point&          start) noexcept;
+  static qreal          calcTravelDistance(const QVector<Point>& hits,
+                                           const Point& start) noexcept;
+
+  // Operator Overloadings
+  DrillPathOptimizer& operator=(const DrillPathOptimizer& rhs) = delete;
+
+private:  // Methods
+  DrillPathOptimizer(const QVector<Point>& hits, const Point& start) noexcept;
+  void         buildGrid() noexcept;
+  int          getCellIndex(int column, int row) const noexcept;
+  QPoint       getCell(const QPointF& pos) const noexcept;
+  QVector<int> findNearest(const QPointF& pos, int count,
+                           int exclude) const noexcept;
+  void         buildNearestNeighbourPath() noexcept;
+  void         improveWithTwoOpt() noexcept;
+  void         reversePath(int first, int last) noexcept;
+  qreal        getDistance(int node1, int node2) const noexcept;
+
+private:  // Data
+  QVector<QPointF>      mNodes;  ///< Node 0 is the start, nm as floating point
+  QRectF                mBounds;
+  qreal                 mCellSize;
+  int                   mColumns;
+  int                   mRows;
+  QVector<QVector<int>> mCells;  ///< Indices of the (remaining) nodes per cell
+  QVector<int>          mPath;         ///< Path over all nodes, starting with 0
+  QVector<int>          mPathIndices;  ///< Position of each node in #mPath
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_DRILLPATHOPTIMIZER_H
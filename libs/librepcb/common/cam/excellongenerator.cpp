@@ -23,6 +23,7 @@
 #include "excellongenerator.h"
 
 #include "../fileio/smarttextfile.h"
+#include "drillpathoptimizer.h"
 
 #include <QtCore>
 
@@ -35,7 +36,8 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-ExcellonGenerator::ExcellonGenerator() noexcept : mOutput() {
+ExcellonGenerator::ExcellonGenerator() noexcept
+  : mOutput(), mOptimizeDrillPath(false) {
 }
 
 ExcellonGenerator::~ExcellonGenerator() noexcept {
@@ -100,10 +102,18 @@ void ExcellonGenerator::printToolList() noexcept {
 }
 
 void ExcellonGenerator::printDrills() noexcept {
+  Point position(0, 0);  // the drills of each tool start where the last ended
   for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
     mOutput.append(QString("T%1\n").arg(i + 1));  // Select Tool
-    Length dia = mDrillList.uniqueKeys().value(i);
-    foreach (const Point& pos, mDrillList.values(dia)) {
+    Length         dia       = mDrillList.uniqueKeys().value(i);
+    QVector<Point> positions = mDrillList.values(dia).toVector();
+    if (mOptimizeDrillPath) {
+      positions = DrillPathOptimizer::optimize(positions, position);
+    }
+    if (!positions.isEmpty()) {
+      position = positions.last();
+    }
+    foreach (const Point& pos, positions) {
       mOutput.append(
           QString("X%1Y%2\n")
               .arg(pos.getX().toMmString(), pos.getY().toMmString()));
@@ -57,6 +57,11 @@ public:
   // Getters
   const QString& toStr() const noexcept { return mOutput; }
 
+  // Setters
+  void setOptimizeDrillPath(bool optimize) noexcept {
+    mOptimizeDrillPath = optimize;
+  }
+
   // General Methods
   void drill(const Point& pos, const PositiveLength& dia) noexcept;
   void generate();
@@ -75,6 +80,7 @@ private:
   // Excellon Data
   QString                  mOutput;
   QMultiMap<Length, Point> mDrillList;
+  bool                     mOptimizeDrillPath;  ///< See DrillPathOptimizer
 };
 
 /*******************************************************************************
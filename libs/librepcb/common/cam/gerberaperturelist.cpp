@@ -49,9 +49,10 @@ QString GerberApertureList::generateString() const noexcept {
   foreach (const QString& macro, mApertureMacros) {
     str.append(QString("%AM%1*%\n").arg(macro));
   }
-  foreach (int number, mApertures.keys()) {
-    str.append(
-        QString("%ADD%1%2*%\n").arg(number).arg(mApertures.value(number)));
+  for (int i = 0; i < mApertures.count(); ++i) {
+    str.append(QString("%ADD%1%2*%\n")
+                   .arg(i + 10)  // 10 is the number of the first aperture
+                   .arg(generateAperture(mApertures.at(i))));
   }
   str.append("G04 --- APERTURE LIST END --- *\n");
   return str;
@@ -63,16 +64,17 @@ QString GerberApertureList::generateString() const noexcept {
 
 int GerberApertureList::setCircle(const UnsignedLength& dia,
                                   const UnsignedLength& hole) {
-  return setCurrentAperture(generateCircle(dia, hole));
+  return setCurrentAperture(Shape::Circle, dia, UnsignedLength(0), Angle(0), 0,
+                            hole);
 }
 
 int GerberApertureList::setRect(const UnsignedLength& w,
                                 const UnsignedLength& h, const Angle& rot,
                                 const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateRect(w, h, hole));
+    return setCurrentAperture(Shape::Rect, w, h, Angle(0), 0, hole);
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateRect(h, w, hole));
+    return setCurrentAperture(Shape::Rect, h, w, Angle(0), 0, hole);
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
     // macro
@@ -81,7 +83,7 @@ int GerberApertureList::setRect(const UnsignedLength& w,
     } else {
       addMacro(generateRotatedRectMacro());
     }
-    return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+    return setCurrentAperture(Shape::RotatedRect, w, h, rot, 0, hole);
   }
 }
 
@@ -89,9 +91,9 @@ int GerberApertureList::setObround(const UnsignedLength& w,
                                    const UnsignedLength& h, const Angle& rot,
                                    const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateObround(w, h, hole));
+    return setCurrentAperture(Shape::Obround, w, h, Angle(0), 0, hole);
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateObround(h, w, hole));
+    return setCurrentAperture(Shape::Obround, h, w, Angle(0), 0, hole);
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
     // macro
@@ -100,7 +102,7 @@ int GerberApertureList::setObround(const UnsignedLength& w,
     } else {
       addMacro(generateRotatedObroundMacro());
     }
-    return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+    return setCurrentAperture(Shape::RotatedObround, w, h, rot, 0, hole);
   }
 }
 
@@ -115,26 +117,33 @@ int GerberApertureList::setRegularPolygon(const UnsignedLength& dia, int n,
   // Adjust rotation as its interpretation differs between LibrePCB and Gerber
   // specs
   Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-  return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+  return setCurrentAperture(Shape::RegularPolygon, dia, UnsignedLength(0),
+                            grbRot, n, hole);
 }
 
 void GerberApertureList::reset() noexcept {
   // mApertureMacros.clear();
   mApertures.clear();
+  mApertureNumbers.clear();
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept {
-  int number = mApertures.key(aperture, -1);
-  if (number < 0) {
-    number = mApertures.count() + 10;  // 10 is the number of the first aperture
-    Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, aperture);
+int GerberApertureList::setCurrentAperture(
+    Shape shape, const UnsignedLength& w, const UnsignedLength& h,
+    const Angle& rot, int vertices, const UnsignedLength& hole) noexcept {
+  // map the rotation to [0..360[ to get the same aperture for equivalent angles
+  Aperture aperture{shape, *w, *h, rot.mappedTo0_360deg(), vertices, *hole};
+  auto     it = mApertureNumbers.find(aperture);
+  if (it == mApertureNumbers.end()) {
+    // 10 is the number of the first aperture
+    int number = mApertures.count() + 10;
+    mApertures.append(aperture);
+    it = mApertureNumbers.insert(aperture, number);
   }
-  return number;
+  return *it;
 }
 
 void GerberApertureList::addMacro(const QString& macro) noexcept {
@@ -147,6 +156,29 @@ void GerberApertureList::addMacro(const QString& macro) noexcept {
  *  Aperture Generator Methods
  ******************************************************************************/
 
+QString GerberApertureList::generateAperture(const Aperture& a) noexcept {
+  UnsignedLength w(a.w);
+  UnsignedLength h(a.h);
+  UnsignedLength hole(a.hole);
+  switch (a.shape) {
+    case Shape::Circle:
+      return generateCircle(w, hole);
+    case Shape::Rect:
+      return generateRect(w, h, hole);
+    case Shape::Obround:
+      return generateObround(w, h, hole);
+    case Shape::RegularPolygon:
+      return generateRegularPolygon(w, a.vertices, a.rot, hole);
+    case Shape::RotatedRect:
+      return generateRotatedRect(w, h, a.rot, hole);
+    case Shape::RotatedObround:
+      return generateRotatedObround(w, h, a.rot, hole);
+    default:
+      qCritical() << "Unhandled aperture shape:" << static_cast<int>(a.shape);
+      return QString();
+  }
+}
+
 QString GerberApertureList::generateCircle(
     const UnsignedLength& dia, const UnsignedLength& hole) noexcept {
   if (hole > 0) {
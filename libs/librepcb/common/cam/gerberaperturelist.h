@@ -42,6 +42,10 @@ namespace librepcb {
 /**
  * @brief The GerberApertureList class
  *
+ * Apertures are identified by a typed key (shape, dimensions, rotation, hole)
+ * which is looked up in a hash, and their Gerber definition strings are only
+ * generated when the aperture list gets written by #generateString().
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -72,11 +76,48 @@ public:
   GerberApertureList& operator=(const GerberApertureList& rhs) = delete;
 
 private:
+  // Private Types
+  enum class Shape {
+    Circle,
+    Rect,
+    Obround,
+    RegularPolygon,
+    RotatedRect,
+    RotatedObround,
+  };
+
+  struct Aperture {
+    Shape  shape;
+    Length w;         ///< Width (or diameter)
+    Length h;         ///< Height (0 if not applicable)
+    Angle  rot;       ///< Rotation, mapped to [0..360[ (0 if not applicable)
+    int    vertices;  ///< Number of vertices (0 if not applicable)
+    Length hole;      ///< Hole diameter (0 if no hole)
+
+    bool operator==(const Aperture& rhs) const noexcept {
+      return (shape == rhs.shape) && (w == rhs.w) && (h == rhs.h) &&
+             (rot == rhs.rot) && (vertices == rhs.vertices) &&
+             (hole == rhs.hole);
+    }
+    friend uint qHash(const Aperture& key, uint seed = 0) noexcept {
+      const uint values[] = {static_cast<uint>(key.shape),
+                             qHash(key.w, seed),
+                             qHash(key.h, seed),
+                             qHash(key.rot, seed),
+                             static_cast<uint>(key.vertices),
+                             qHash(key.hole, seed)};
+      return qHashBits(values, sizeof(values), seed);
+    }
+  };
+
   // Private Methods
-  int  setCurrentAperture(const QString& aperture) noexcept;
+  int  setCurrentAperture(Shape shape, const UnsignedLength& w,
+                          const UnsignedLength& h, const Angle& rot,
+                          int vertices, const UnsignedLength& hole) noexcept;
   void addMacro(const QString& macro) noexcept;
 
   // Aperture Generator Methods
+  static QString generateAperture(const Aperture& a) noexcept;
   static QString generateCircle(const UnsignedLength& dia,
                                 const UnsignedLength& hole) noexcept;
   static QString generateRect(const UnsignedLength& w, const UnsignedLength& h,
@@ -99,9 +140,9 @@ private:
                                         const Angle&          rot,
                                         const UnsignedLength& hole) noexcept;
 
-  QList<QString> mApertureMacros;
-  QMap<int, QString>
-      mApertures;  ///< key: aperture number (>= 10); value: aperture definition
+  QList<QString>       mApertureMacros;
+  QVector<Aperture>    mApertures;        ///< index: aperture number - 10
+  QHash<Aperture, int> mApertureNumbers;  ///< value: aperture number (>= 10)
 };
 
 /*******************************************************************************
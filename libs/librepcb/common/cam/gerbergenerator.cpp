@@ -22,7 +22,7 @@
  ******************************************************************************/
 #include "gerbergenerator.h"
 
-#include "../fileio/smarttextfile.h"
+#include "../fileio/fileutils.h"
 #include "../geometry/circle.h"
 #include "../geometry/path.h"
 #include "../toolbox.h"
@@ -35,6 +35,9 @@
  ******************************************************************************/
 namespace librepcb {
 
+/// Content size at which the buffered content is spooled to the temporary file
+static constexpr int sContentSpoolSize = 1024 * 1024;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -44,8 +47,9 @@ GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
   : mProjectId(escapeString(projName)),
     mProjectUuid(projUuid),
     mProjectRevision(escapeString(projRevision)),
-    mOutput(),
     mContent(),
+    mContentSpool(),
+    mContentSpoolFailed(false),
     mApertureList(new GerberApertureList()),
     mCurrentApertureNumber(-1),
     mMultiQuadrantArcModeOn(false) {
@@ -61,10 +65,10 @@ GerberGenerator::~GerberGenerator() noexcept {
 void GerberGenerator::setLayerPolarity(LayerPolarity p) noexcept {
   switch (p) {
     case LayerPolarity::Positive:
-      mContent.append("%LPD*%\n");
+      appendContent("%LPD*%\n");
       break;
     case LayerPolarity::Negative:
-      mContent.append("%LPC*%\n");
+      appendContent("%LPC*%\n");
       break;
     default:
       qCritical() << "Invalid Layer Polarity:" << static_cast<int>(p);
@@ -193,79 +197,113 @@ void GerberGenerator::flashRegularPolygon(const Point&          pos,
  ******************************************************************************/
 
 void GerberGenerator::reset() noexcept {
-  mOutput.clear();
   mContent.clear();
+  mContentSpool.reset();
+  mContentSpoolFailed = false;
   mApertureList->reset();
   mCurrentApertureNumber = -1;
 }
 
-void GerberGenerator::generate() {
-  mOutput.clear();
-  printHeader();
-  printApertureList();
-  printContent();
-  printFooter();
+void GerberGenerator::generate(QIODevice& device) {
+  QCryptographicHash md5(QCryptographicHash::Md5);
+  printHeader(device, md5);        // can throw
+  printApertureList(device, md5);  // can throw
+  printContent(device, md5);       // can throw
+  printFooter(device, md5);        // can throw
 }
 
-void GerberGenerator::saveToFile(const FilePath& filepath) const {
-  QScopedPointer<SmartTextFile> file(SmartTextFile::create(filepath));
-  file->setContent(mOutput.toLatin1());
-  file->save(true);
+void GerberGenerator::saveToFile(const FilePath& filepath) {
+  FileUtils::makePath(filepath.getParentDir());  // can throw
+  QSaveFile file(filepath.toStr());
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not open or create file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
+  generate(file);  // can throw
+  if (!file.commit()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not write to file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+void GerberGenerator::appendContent(const QString& str) noexcept {
+  mContent.append(str.toLatin1());
+  if ((mContent.size() >= sContentSpoolSize) && (!mContentSpoolFailed)) {
+    if (!mContentSpool) {
+      mContentSpool.reset(new QTemporaryFile());
+      if (!mContentSpool->open()) {
+        qWarning() << "Could not create temporary Gerber file:"
+                   << mContentSpool->errorString();
+        mContentSpool.reset();
+        mContentSpoolFailed = true;  // keep all content in memory instead
+        return;
+      }
+    }
+    if (mContentSpool->write(mContent) == mContent.size()) {
+      mContent.clear();
+    } else {
+      qWarning() << "Could not write temporary Gerber file:"
+                 << mContentSpool->errorString();
+      mContentSpoolFailed = true;  // spool is incomplete, content is lost
+    }
+  }
+}
+
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    appendContent(QString("D%1*\n").arg(number));
     mCurrentApertureNumber = number;
   }
 }
 
 void GerberGenerator::setRegionModeOn() noexcept {
-  mContent.append("G36*\n");
+  appendContent("G36*\n");
 }
 
 void GerberGenerator::setRegionModeOff() noexcept {
-  mContent.append("G37*\n");
+  appendContent("G37*\n");
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOn() noexcept {
   if (!mMultiQuadrantArcModeOn) {
-    mContent.append("G75*\n");
+    appendContent("G75*\n");
     mMultiQuadrantArcModeOn = true;
   }
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOff() noexcept {
   if (mMultiQuadrantArcModeOn) {
-    mContent.append("G74*\n");
+    appendContent("G74*\n");
     mMultiQuadrantArcModeOn = false;
   }
 }
 
 void GerberGenerator::switchToLinearInterpolationModeG01() noexcept {
-  mContent.append("G01*\n");
+  appendContent("G01*\n");
 }
 
 void GerberGenerator::switchToCircularCwInterpolationModeG02() noexcept {
-  mContent.append("G02*\n");
+  appendContent("G02*\n");
 }
 
 void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
-  mContent.append("G03*\n");
+  appendContent("G03*\n");
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D02*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D01*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
@@ -275,81 +313,120 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start,
   if (!mMultiQuadrantArcModeOn) {
     diff.makeAbs();  // no sign allowed in single quadrant mode!
   }
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  appendContent(QString("X%1Y%2I%3J%4D01*\n")
+                    .arg(end.getX().toNmString(), end.getY().toNmString(),
+                         diff.getX().toNmString(), diff.getY().toNmString()));
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D03*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
-void GerberGenerator::printHeader() noexcept {
-  mOutput.append("G04 --- HEADER BEGIN --- *\n");
+void GerberGenerator::printHeader(QIODevice&          device,
+                                  QCryptographicHash& md5) const {
+  QString header;
+  header.append("G04 --- HEADER BEGIN --- *\n");
 
   // add some X2 attributes
   QString appVersion   = qApp->applicationVersion();
   QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-  QString projId       = mProjectId.remove(',');
+  QString projId       = QString(mProjectId).remove(',');
   QString projUuid     = mProjectUuid.toStr();
-  QString projRevision = mProjectRevision.remove(',');
-  mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
-                     .arg(appVersion));
-  mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
-  mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
-                     .arg(projId, projUuid, projRevision));
-  mOutput.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
-  // mOutput.append("%TF.FilePolarity,Positive*%\n");
+  QString projRevision = QString(mProjectRevision).remove(',');
+  header.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
+                    .arg(appVersion));
+  header.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
+  header.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
+                    .arg(projId, projUuid, projRevision));
+  header.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
+  // header.append("%TF.FilePolarity,Positive*%\n");
 
   // coordinate format specification:
   //  - leading zeros omitted
   //  - absolute coordinates
   //  - coordiante format "6.6" --> allows us to directly use LengthBase_t
   //  (nanometers)!
-  mOutput.append("%FSLAX66Y66*%\n");
+  header.append("%FSLAX66Y66*%\n");
 
   // set unit to millimeters
-  mOutput.append("%MOMM*%\n");
+  header.append("%MOMM*%\n");
 
   // start linear interpolation mode
-  mOutput.append("G01*\n");
+  header.append("G01*\n");
 
   // use single quadrant arc mode
-  mOutput.append("G74*\n");
+  header.append("G74*\n");
 
-  mOutput.append("G04 --- HEADER END --- *\n");
+  header.append("G04 --- HEADER END --- *\n");
+  write(device, md5, header.toLatin1());  // can throw
 }
 
-void GerberGenerator::printApertureList() noexcept {
-  mOutput.append(mApertureList->generateString());
+void GerberGenerator::printApertureList(QIODevice&          device,
+                                        QCryptographicHash& md5) const {
+  write(device, md5, mApertureList->generateString().toLatin1());  // can throw
 }
 
-void GerberGenerator::printContent() noexcept {
-  mOutput.append("G04 --- BOARD BEGIN --- *\n");
-  mOutput.append(mContent);
-  mOutput.append("G04 --- BOARD END --- *\n");
+void GerberGenerator::printContent(QIODevice&          device,
+                                   QCryptographicHash& md5) {
+  if (mContentSpoolFailed && mContentSpool) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not write temporary Gerber file: %1"))
+                           .arg(mContentSpool->errorString()));
+  }
+  write(device, md5, "G04 --- BOARD BEGIN --- *\n");  // can throw
+  if (mContentSpool) {
+    // copy the spooled content chunk by chunk to keep memory usage low
+    if (!mContentSpool->seek(0)) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         QString(tr("Could not read temporary Gerber file: %1"))
+                             .arg(mContentSpool->errorString()));
+    }
+    while (!mContentSpool->atEnd()) {
+      QByteArray chunk = mContentSpool->read(sContentSpoolSize);
+      if (chunk.isEmpty()) {
+        throw RuntimeError(
+            __FILE__, __LINE__,
+            QString(tr("Could not read temporary Gerber file: %1"))
+                .arg(mContentSpool->errorString()));
+      }
+      write(device, md5, chunk);  // can throw
+    }
+    mContentSpool->seek(mContentSpool->size());  // continue appending content
+  }
+  write(device, md5, mContent);                     // can throw
+  write(device, md5, "G04 --- BOARD END --- *\n");  // can throw
 }
 
-void GerberGenerator::printFooter() noexcept {
+void GerberGenerator::printFooter(QIODevice&          device,
+                                  QCryptographicHash& md5) const {
   // MD5 checksum over content
-  mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
+  QByteArray checksum = md5.result().toHex();
+  write(device, "%TF.MD5," + checksum + "*%\n");  // can throw
 
   // end of file
-  mOutput.append("M02*\n");
+  write(device, "M02*\n");  // can throw
 }
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+void GerberGenerator::write(QIODevice& device, QCryptographicHash& md5,
+                            const QByteArray& data) {
   // according to the RS-274C standard, linebreaks are not included in the
   // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  md5.addData(QByteArray(data).replace('\n', QByteArray()));
+  write(device, data);  // can throw
 }
 
-/*******************************************************************************
- *  Static Methods
- ******************************************************************************/
+void GerberGenerator::write(QIODevice& device, const QByteArray& data) {
+  if (device.write(data) != data.size()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not write Gerber data: %1"))
+                           .arg(device.errorString()));
+  }
+}
 
 QString GerberGenerator::escapeString(const QString& str) noexcept {
   // perform compatibility decomposition (NFKD)
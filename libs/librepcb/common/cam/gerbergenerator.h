@@ -46,6 +46,12 @@ class GerberApertureList;
 /**
  * @brief The GerberGenerator class
  *
+ * The drawn content is kept as ASCII bytes in a small buffer which is spooled
+ * to a temporary file when it grows, so memory usage stays bounded even for
+ * huge layers. The final file is then streamed to a device by #generate(),
+ * with the aperture list (which is only known at the end) written in front of
+ * the spooled content and the MD5 checksum calculated on the fly.
+ *
  * @todo Remove/Escape illegal characters in #mProjectId and #mProjectRevision!
  * @todo Use file/aperture attributes
  *
@@ -68,9 +74,6 @@ public:
                   const QString& projRevision) noexcept;
   ~GerberGenerator() noexcept;
 
-  // Getters
-  const QString& toStr() const noexcept { return mOutput; }
-
   // Plot Methods
   void setLayerPolarity(LayerPolarity p) noexcept;
   void drawLine(const Point& start, const Point& end,
@@ -94,34 +97,37 @@ public:
 
   // General Methods
   void reset() noexcept;
-  void generate();
-  void saveToFile(const FilePath& filepath) const;
+  void generate(QIODevice& device);
+  void saveToFile(const FilePath& filepath);
 
   // Operator Overloadings
   GerberGenerator& operator=(const GerberGenerator& rhs) = delete;
 
 private:
   // Private Methods
-  void    setCurrentAperture(int number) noexcept;
-  void    setRegionModeOn() noexcept;
-  void    setRegionModeOff() noexcept;
-  void    setMultiQuadrantArcModeOn() noexcept;
-  void    setMultiQuadrantArcModeOff() noexcept;
-  void    switchToLinearInterpolationModeG01() noexcept;
-  void    switchToCircularCwInterpolationModeG02() noexcept;
-  void    switchToCircularCcwInterpolationModeG03() noexcept;
-  void    moveToPosition(const Point& pos) noexcept;
-  void    linearInterpolateToPosition(const Point& pos) noexcept;
-  void    circularInterpolateToPosition(const Point& start, const Point& center,
-                                        const Point& end) noexcept;
-  void    flashAtPosition(const Point& pos) noexcept;
-  void    printHeader() noexcept;
-  void    printApertureList() noexcept;
-  void    printContent() noexcept;
-  void    printFooter() noexcept;
-  QString calcOutputMd5Checksum() const noexcept;
+  void appendContent(const QString& str) noexcept;
+  void setCurrentAperture(int number) noexcept;
+  void setRegionModeOn() noexcept;
+  void setRegionModeOff() noexcept;
+  void setMultiQuadrantArcModeOn() noexcept;
+  void setMultiQuadrantArcModeOff() noexcept;
+  void switchToLinearInterpolationModeG01() noexcept;
+  void switchToCircularCwInterpolationModeG02() noexcept;
+  void switchToCircularCcwInterpolationModeG03() noexcept;
+  void moveToPosition(const Point& pos) noexcept;
+  void linearInterpolateToPosition(const Point& pos) noexcept;
+  void circularInterpolateToPosition(const Point& start, const Point& center,
+                                     const Point& end) noexcept;
+  void flashAtPosition(const Point& pos) noexcept;
+  void printHeader(QIODevice& device, QCryptographicHash& md5) const;
+  void printApertureList(QIODevice& device, QCryptographicHash& md5) const;
+  void printContent(QIODevice& device, QCryptographicHash& md5);
+  void printFooter(QIODevice& device, QCryptographicHash& md5) const;
 
   // Static Methods
+  static void    write(QIODevice& device, QCryptographicHash& md5,
+                       const QByteArray& data);
+  static void    write(QIODevice& device, const QByteArray& data);
   static QString escapeString(const QString& str) noexcept;
 
   // Metadata
@@ -130,8 +136,9 @@ private:
   QString mProjectRevision;
 
   // Gerber Data
-  QString                            mOutput;
-  QString                            mContent;
+  QByteArray                         mContent;       ///< Unspooled content
+  QScopedPointer<QTemporaryFile>     mContentSpool;  ///< Spooled content
+  bool                               mContentSpoolFailed;
   QScopedPointer<GerberApertureList> mApertureList;
   int                                mCurrentApertureNumber;
   bool                               mMultiQuadrantArcModeOn;
@@ -23,7 +23,6 @@ INCLUDEPATH += \
     ../../ \
     ../../fontobene \
     ../../quazip \
-    ../../sexpresso \
     ../../type_safe/include \
     ../../type_safe/external/debug_assert \
 
@@ -44,6 +43,7 @@ SOURCES += \
     attributes/attrtypestring.cpp \
     attributes/attrtypevoltage.cpp \
     boarddesignrules.cpp \
+    cam/drillpathoptimizer.cpp \
     cam/excellongenerator.cpp \
     cam/gerberaperturelist.cpp \
     cam/gerbergenerator.cpp \
@@ -58,6 +58,7 @@ SOURCES += \
     dialogs/stroketextpropertiesdialog.cpp \
     dialogs/textpropertiesdialog.cpp \
     exceptions.cpp \
+    fileio/asyncsexprfilewriter.cpp \
     fileio/directorylock.cpp \
     fileio/filepath.cpp \
     fileio/fileutils.cpp \
@@ -76,6 +77,7 @@ SOURCES += \
     geometry/cmd/cmdtextedit.cpp \
     geometry/hole.cpp \
     geometry/path.cpp \
+    geometry/pathcontainmentindex.cpp \
     geometry/polygon.cpp \
     geometry/stroketext.cpp \
     geometry/text.cpp \
@@ -149,6 +151,7 @@ HEADERS += \
     attributes/attrtypestring.h \
     attributes/attrtypevoltage.h \
     boarddesignrules.h \
+    cam/drillpathoptimizer.h \
     cam/excellongenerator.h \
     cam/gerberaperturelist.h \
     cam/gerbergenerator.h \
@@ -165,6 +168,7 @@ HEADERS += \
     dialogs/textpropertiesdialog.h \
     elementname.h \
     exceptions.h \
+    fileio/asyncsexprfilewriter.h \
     fileio/cmd/cmdlistelementinsert.h \
     fileio/cmd/cmdlistelementremove.h \
     fileio/cmd/cmdlistelementsswap.h \
@@ -189,6 +193,7 @@ HEADERS += \
     geometry/cmd/cmdtextedit.h \
     geometry/hole.h \
     geometry/path.h \
+    geometry/pathcontainmentindex.h \
     geometry/polygon.h \
     geometry/stroketext.h \
     geometry/text.h \
@@ -233,6 +238,7 @@ HEADERS += \
     utils/clipperhelpers.h \
     utils/exclusiveactiongroup.h \
     utils/graphicslayerstackappearancesettings.h \
+    utils/rtree.h \
     utils/toolbarproxy.h \
     utils/undostackactiongroup.h \
     uuid.h \
@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "asyncsexprfilewriter.h"
+
+#include "../exceptions.h"
+#include "smartsexprfile.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+AsyncSExprFileWriter::AsyncSExprFileWriter(QObject* parent) noexcept
+  : QObject(parent) {
+  connect(&mWatcher, &QFutureWatcherBase::progressValueChanged, this,
+          [this](int value) {
+            int maximum = qMax(mWatcher.progressMaximum(), 1);
+            emit progressChanged((100 * value) / maximum);
+          });
+  connect(&mWatcher, &QFutureWatcherBase::finished, this,
+          &AsyncSExprFileWriter::writingFinished);
+}
+
+AsyncSExprFileWriter::~AsyncSExprFileWriter() noexcept {
+  waitForFinished();
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool AsyncSExprFileWriter::isRunning() const noexcept {
+  return mWatcher.isRunning();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void AsyncSExprFileWriter::addFile(const FilePath& filepath,
+                                   SExpression&&   document) {
+  if (isRunning()) {
+    throw LogicError(__FILE__, __LINE__, tr("The writer is already running."));
+  }
+  mPendingJobs.append(
+      std::make_shared<const Job>(Job{filepath, std::move(document)}));
+}
+
+void AsyncSExprFileWriter::start() {
+  if (isRunning()) {
+    throw LogicError(__FILE__, __LINE__, tr("The writer is already running."));
+  }
+  // Each file is written by a separate task of the global thread pool, so the
+  // progress is reported per file.
+  mWatcher.setFuture(
+      QtConcurrent::mapped(mPendingJobs, &AsyncSExprFileWriter::write));
+  mPendingJobs.clear();
+  emit started();
+}
+
+void AsyncSExprFileWriter::waitForFinished() noexcept {
+  mWatcher.waitForFinished();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void AsyncSExprFileWriter::writingFinished() noexcept {
+  QStringList errors;
+  foreach (const QString& error, mWatcher.future().results()) {
+    if (!error.isEmpty()) {
+      errors.append(error);
+    }
+  }
+  emit finished(errors);
+}
+
+QString AsyncSExprFileWriter::write(
+    const std::shared_ptr<const Job>& job) noexcept {
+  try {
+    SmartSExprFile::writeFile(job->filepath, job->document);  // can throw
+    return QString();
+  } catch (const Exception& e) {
+    return e.getMsg();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,130 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_ASYNCSEXPRFILEWRITER_H
+#define LIBREPCB_ASYNCSEXPRFILEWRITER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "filepath.h"
+#include "sexpression.h"
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class AsyncSExprFileWriter
+ ******************************************************************************/
+
+/**
+ * @brief The AsyncSExprFileWriter class writes S-Expression files in the
+ * background
+ *
+ * Building the DOM trees of a document requires access to the (not thread
+ * safe) data model, so it has to be done in the main thread. But formatting
+ * the DOM trees and writing them to the file system is the expensive part for
+ * large documents and does only depend on the DOM trees. So this class takes
+ * the DOM trees as snapshots with #addFile() and writes all of them in worker
+ * threads after calling #start(), without blocking the main thread.
+ *
+ * @see librepcb::SmartSExprFile::save()
+ */
+class AsyncSExprFileWriter final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  AsyncSExprFileWriter(const AsyncSExprFileWriter& other) = delete;
+  explicit AsyncSExprFileWriter(QObject* parent = nullptr) noexcept;
+
+  /**
+   * @brief The destructor (blocks until all files are written)
+   */
+  ~AsyncSExprFileWriter() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Check whether files are currently written in the background
+   *
+   * @return True between #start() and the #finished() signal
+   */
+  bool isRunning() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Add a file to write with the next call to #start()
+   *
+   * @param filepath  The file to write (parent directories are created)
+   * @param document  The DOM tree to write (will be moved into this object)
+   *
+   * @throw Exception If the writer is currently running.
+   */
+  void addFile(const FilePath& filepath, SExpression&& document);
+
+  /**
+   * @brief Start writing all added files in the background
+   *
+   * @throw Exception If the writer is already running.
+   */
+  void start();
+
+  /**
+   * @brief Block until all files of the current run are written
+   */
+  void waitForFinished() noexcept;
+
+  // Operator Overloadings
+  AsyncSExprFileWriter& operator=(const AsyncSExprFileWriter& rhs) = delete;
+
+signals:
+  void started();
+  void progressChanged(int percent);
+  void finished(const QStringList& errors);
+
+private:  // Types
+  struct Job {
+    FilePath    filepath;
+    SExpression document;
+  };
+
+private:  // Methods
+  void writingFinished() noexcept;
+  static QString write(const std::shared_ptr<const Job>& job) noexcept;
+
+private:  // Data
+  QList<std::shared_ptr<const Job>> mPendingJobs;
+  QFutureWatcher<QString>           mWatcher;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_ASYNCSEXPRFILEWRITER_H
@@ -54,6 +54,14 @@ public:
       mIndex(-1) {}
   ~CmdListElementRemove() noexcept {}
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override {
+    return UndoCommand::getMemoryUsage() +
+           (sizeof(CmdListElementRemove) - sizeof(UndoCommand)) + sizeof(T);
+  }
+
   // Operator Overloadings
   CmdListElementRemove& operator=(const CmdListElementRemove& rhs) = delete;
 
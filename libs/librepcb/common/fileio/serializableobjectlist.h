@@ -29,6 +29,7 @@
 #include <QtCore>
 
 #include <memory>
+#include <type_traits>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -51,7 +52,8 @@ namespace librepcb {
  * librepcb::DomElement.
  * - Iterators (for example to use in C++11 range based for loops).
  * - Methods to find elements by UUID and/or name (if supported by template type
- * `T`).
+ * `T`). Elements are found by UUID in constant time using a hash index which
+ * is updated whenever elements are added or removed.
  * - Method #sortedByUuid() to create a copy of the list with elements sorted by
  * UUID.
  * - Observer pattern to get notified about added and removed elements.
@@ -69,7 +71,9 @@ namespace librepcb {
  *              - Optional: A method `serialize()` according to
  * librepcb::SerializableObject
  *              - Optional: Comparison operator overloadings
- *              - Optional: A method `Uuid getUuid() const noexcept`
+ *              - Optional: A method `Uuid getUuid() const noexcept` (the UUID
+ * must never change while the element is contained in a list since the UUID
+ * index is not updated then, so the element could not be found anymore)
  *              - Optional: A method `QString getName() const noexcept`
  * @tparam P  A class which provides the S-Expression node tag name of the list
  * items. Example: `struct MyNameProvider {static constexpr const char* tagname
@@ -139,13 +143,15 @@ public:
   }
   SerializableObjectList(SerializableObjectList<T, P>&& other,
                          IF_Observer* observer = nullptr) noexcept {
-    mObjects = other.mObjects;  // copy all pointers (NOT the objects!)
+    mObjects   = other.mObjects;  // copy all pointers (NOT the objects!)
+    mUuidIndex = other.mUuidIndex;
     other.clear();  // remove all other's elements with notifying its observers
     if (observer) registerObserver(observer);
   }
   SerializableObjectList(std::initializer_list<std::shared_ptr<T>> elements,
                          IF_Observer* observer = nullptr) noexcept {
     mObjects = elements;
+    rebuildUuidIndex(hasUuid<T>(0));
     if (observer) registerObserver(observer);
   }
   SerializableObjectList(std::initializer_list<T> elements,
@@ -193,12 +199,9 @@ public:
     return -1;
   }
   int indexOf(const Uuid& key) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i]->getUuid() == key) {
-        return i;
-      }
-    }
-    return -1;
+    int index = mUuidIndex.value(key, -1);
+    Q_ASSERT((index < 0) || (mObjects[index]->getUuid() == key));
+    return index;
   }
   int indexOf(const QString& name) const noexcept {
     for (int i = 0; i < count(); ++i) {
@@ -301,6 +304,7 @@ public:
     Q_ASSERT(obj);
     qBound(0, index, count());
     mObjects.insert(index, obj);
+    updateUuidIndexAfterInsert(index, hasUuid<T>(0));
     notifyObjectAdded(index, obj);
     return index;
   }
@@ -310,6 +314,7 @@ public:
   std::shared_ptr<T> take(int index) noexcept {
     Q_ASSERT(contains(index));
     std::shared_ptr<T> obj = mObjects.takeAt(index);
+    updateUuidIndexAfterRemove(index, *obj, hasUuid<T>(0));
     notifyObjectRemoved(index, obj);
     return std::move(obj);
   }
@@ -343,6 +348,7 @@ public:
           [](const std::shared_ptr<T>& ptr1, const std::shared_ptr<T>& ptr2) {
             return ptr1->getUuid() < ptr2->getUuid();
           });
+    copiedList.rebuildUuidIndex(hasUuid<T>(0));
     return copiedList;
   }
   SerializableObjectList<T, P> sortedByName() const noexcept {
@@ -352,6 +358,7 @@ public:
           [](const std::shared_ptr<T>& ptr1, const std::shared_ptr<T>& ptr2) {
             return ptr1->getName() < ptr2->getName();
           });
+    copiedList.rebuildUuidIndex(hasUuid<T>(0));
     return copiedList;
   }
 
@@ -434,9 +441,54 @@ protected:  // Methods
             .arg(name));
   }
 
+  // UUID Index Methods (only doing something if T provides getUuid())
+  template <typename U>
+  static auto hasUuid(int) noexcept
+      -> decltype(std::declval<const U&>().getUuid(), std::true_type()) {
+    return std::true_type();
+  }
+  template <typename U>
+  static std::false_type hasUuid(...) noexcept {
+    return std::false_type();
+  }
+  void updateUuidIndexAfterInsert(int index, std::true_type) noexcept {
+    if (index == mObjects.count() - 1) {
+      // appended, the indices of the other elements did not change
+      Uuid uuid = mObjects.at(index)->getUuid();
+      if (!mUuidIndex.contains(uuid)) {
+        mUuidIndex.insert(uuid, index);
+      }
+    } else {
+      rebuildUuidIndex(std::true_type());
+    }
+  }
+  void updateUuidIndexAfterInsert(int, std::false_type) noexcept {}
+  void updateUuidIndexAfterRemove(int index, const T& obj,
+                                  std::true_type) noexcept {
+    if (index == mObjects.count()) {
+      // last element removed, the indices of the other elements did not change
+      auto it = mUuidIndex.find(obj.getUuid());
+      if ((it != mUuidIndex.end()) && (it.value() == index)) {
+        mUuidIndex.erase(it);
+      }
+    } else {
+      rebuildUuidIndex(std::true_type());
+    }
+  }
+  void updateUuidIndexAfterRemove(int, const T&, std::false_type) noexcept {}
+  void rebuildUuidIndex(std::true_type) noexcept {
+    mUuidIndex.clear();
+    mUuidIndex.reserve(mObjects.count());
+    for (int i = mObjects.count() - 1; i >= 0; --i) {
+      mUuidIndex.insert(mObjects.at(i)->getUuid(), i);  // first one wins
+    }
+  }
+  void rebuildUuidIndex(std::false_type) noexcept {}
+
 protected:  // Data
   QVector<std::shared_ptr<T>> mObjects;
   QList<IF_Observer*>         mObservers;
+  QHash<Uuid, int>            mUuidIndex;  ///< UUID -> index of first element
 };
 
 }  // namespace librepcb
@@ -22,8 +22,6 @@
  ******************************************************************************/
 #include "sexpression.h"
 
-#include <sexpresso/sexpresso.hpp>
-
 #include <QtCore>
 
 /*******************************************************************************
@@ -31,46 +29,229 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Struct SExpression::ParseContext
+ ******************************************************************************/
+
+/**
+ * @brief State of the single-pass parser working on a UTF-8 buffer
+ *
+ * The parser reads directly from the (immutable) input buffer and keeps track
+ * of the current line and column to allow meaningful error messages.
+ *
+ * Short tokens (list names like "vertex" or values like "0.0" or "none") are
+ * interned per document, so all equal tokens share the same implicitly shared
+ * QString instead of allocating a new string for every occurrence.
+ */
+struct SExpression::ParseContext {
+  ParseContext(const QByteArray& content, const FilePath& fp) noexcept
+    : filePath(fp),
+      pos(content.constData()),
+      end(content.constData() + content.size()),
+      line(1),
+      lineStart(pos),
+      columnPos(pos),
+      column(1) {}
+
+  bool atEnd() const noexcept { return pos >= end; }
+
+  void newLine() noexcept {
+    ++line;
+    lineStart = pos + 1;
+  }
+
+  int getColumn() noexcept {
+    // count UTF-8 code points (not bytes) since the last known column
+    if (columnPos < lineStart) {
+      columnPos = lineStart;
+      column    = 1;
+    }
+    for (; columnPos < pos; ++columnPos) {
+      if ((static_cast<uchar>(*columnPos) & 0xC0) != 0x80) ++column;
+    }
+    return column;
+  }
+
+  QString intern(const char* data, int size) noexcept {
+    if (size > 16) {
+      return QString::fromUtf8(data, size);  // most likely a unique value
+    }
+    QLatin1String key(data, size);  // points into the (immutable) input buffer
+    auto          it = internedTokens.constFind(key);
+    if (it == internedTokens.constEnd()) {
+      it = internedTokens.insert(key, QString::fromUtf8(data, size));
+    }
+    return *it;
+  }
+
+  [[noreturn]] void throwError(const QString& msg, const char* from = nullptr) {
+    QString content;
+    if (from) {
+      content = QString::fromUtf8(from, qMin<int>(end - from, 64));
+    }
+    throw FileParseError(__FILE__, __LINE__, filePath, line, getColumn(),
+                         content, msg);
+  }
+
+  const FilePath& filePath;
+  const char*     pos;
+  const char*     end;
+  int             line;       ///< current line number (1-based)
+  const char*     lineStart;  ///< first character of the current line
+  const char*     columnPos;  ///< position where #column was calculated
+  int             column;     ///< column number (1-based) at #columnPos
+  QHash<QLatin1String, QString> internedTokens;
+};
+
+static inline bool isSExprWhitespace(char c) noexcept {
+  return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') ||
+         (c == '\v') || (c == '\f');
+}
+
+/*******************************************************************************
+ *  Struct SExpression::SerializeContext
+ ******************************************************************************/
+
+/**
+ * @brief State of the serializer writing UTF-8 into a reusable buffer
+ *
+ * If a device is set, the buffer is flushed to it whenever it exceeds
+ * #sFlushSize, so the memory usage does not depend on the document size.
+ */
+struct SExpression::SerializeContext {
+  explicit SerializeContext(QIODevice* d) noexcept
+    : device(d), lastIsSpace(false) {
+    buffer.reserve(device ? (sFlushSize + 4096) : 4096);
+  }
+
+  void append(char c) noexcept {
+    buffer.append(c);
+    lastIsSpace = (c == ' ') || (c == '\n');
+  }
+
+  void appendLineBreak(int indent) {
+    buffer.append('\n');
+    for (int i = 0; i < indent; ++i) {
+      buffer.append(' ');
+    }
+    lastIsSpace = true;
+    flushIfNeeded();  // can throw
+  }
+
+  void appendAscii(const QString& str) noexcept {
+    // Note: Only used for validated list names and tokens, i.e. pure ASCII.
+    for (const QChar& c : str) {
+      buffer.append(static_cast<char>(c.unicode()));
+    }
+    lastIsSpace = false;
+  }
+
+  void appendEscaped(const QString& str) noexcept {
+    const int length = str.length();
+    for (int i = 0; i < length; ++i) {
+      ushort c = str.at(i).unicode();
+      switch (c) {
+        case '\'': buffer.append("\\'"); break;
+        case '"': buffer.append("\\\""); break;
+        case '?': buffer.append("\\?"); break;
+        case '\\': buffer.append("\\\\"); break;
+        case '\a': buffer.append("\\a"); break;
+        case '\b': buffer.append("\\b"); break;
+        case '\f': buffer.append("\\f"); break;
+        case '\n': buffer.append("\\n"); break;
+        case '\r': buffer.append("\\r"); break;
+        case '\t': buffer.append("\\t"); break;
+        case '\v': buffer.append("\\v"); break;
+        default:
+          if (c < 0x80) {
+            buffer.append(static_cast<char>(c));
+          } else if (c < 0x800) {
+            buffer.append(static_cast<char>(0xC0 | (c >> 6)));
+            buffer.append(static_cast<char>(0x80 | (c & 0x3F)));
+          } else if (QChar::isHighSurrogate(c) && (i + 1 < length) &&
+                     str.at(i + 1).isLowSurrogate()) {
+            uint ucs4 = QChar::surrogateToUcs4(c, str.at(++i).unicode());
+            buffer.append(static_cast<char>(0xF0 | (ucs4 >> 18)));
+            buffer.append(static_cast<char>(0x80 | ((ucs4 >> 12) & 0x3F)));
+            buffer.append(static_cast<char>(0x80 | ((ucs4 >> 6) & 0x3F)));
+            buffer.append(static_cast<char>(0x80 | (ucs4 & 0x3F)));
+          } else if (QChar::isSurrogate(c)) {
+            buffer.append("\xEF\xBF\xBD");  // invalid, replacement character
+          } else {
+            buffer.append(static_cast<char>(0xE0 | (c >> 12)));
+            buffer.append(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            buffer.append(static_cast<char>(0x80 | (c & 0x3F)));
+          }
+          break;
+      }
+    }
+    lastIsSpace = false;
+  }
+
+  void flushIfNeeded() {
+    if (device && (buffer.size() >= sFlushSize)) {
+      flush();  // can throw
+    }
+  }
+
+  void flush() {
+    if (device && (!buffer.isEmpty())) {
+      if (device->write(buffer) != buffer.size()) {
+        throw RuntimeError(
+            __FILE__, __LINE__,
+            QString(tr("Could not write S-Expression: %1"))
+                .arg(device->errorString()));
+      }
+      buffer.resize(0);  // keeps the reserved capacity
+    }
+  }
+
+  static constexpr int sFlushSize = 64 * 1024;
+
+  QIODevice* device;       ///< the output device (nullptr = buffer only)
+  QByteArray buffer;       ///< the buffered (not yet flushed) output
+  bool       lastIsSpace;  ///< whether the last written char was whitespace
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
-SExpression::SExpression() noexcept : mType(Type::String) {
+SExpression::SExpression() noexcept
+  : mType(Type::String), mFileLine(-1), mFileColumn(-1) {
 }
 
 SExpression::SExpression(Type type, const QString& value)
-  : mType(type), mValue(value) {
+  : mType(type), mValue(value), mFileLine(-1), mFileColumn(-1) {
+}
+
+SExpression::SExpression(Type type, const QString& value,
+                         const FilePath& filePath, int fileLine, int fileColumn)
+  : mType(type),
+    mValue(value),
+    mFilePath(filePath),
+    mFileLine(fileLine),
+    mFileColumn(fileColumn) {
 }
 
 SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
     mValue(other.mValue),
     mChildren(other.mChildren),
-    mFilePath(other.mFilePath) {
+    mFilePath(other.mFilePath),
+    mFileLine(other.mFileLine),
+    mFileColumn(other.mFileColumn),
+    mChildIndex(other.mChildIndex) {
 }
 
-SExpression::SExpression(sexpresso::Sexp& sexp, const FilePath& filePath)
-  : mType(Type::List), mValue(), mFilePath(filePath) {
-  if (sexp.childCount() < 1) {
-    throw RuntimeError(__FILE__, __LINE__);
-  }
-
-  if (sexp.isSexp()) {
-    sexpresso::Sexp& first = sexp.getChild(0);
-    if (!first.isString()) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    mValue = QString::fromStdString(first.getString());
-    for (auto&& arg : sexp.arguments()) {
-      mChildren.append(SExpression(arg, filePath));
-    }
-  } else if (sexp.isString()) {
-    mValue = QString::fromStdString(sexp.getString());
-    mType  = Type::String;
-  } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Unknown node type."));
-  }
+SExpression::SExpression(SExpression&& other) noexcept
+  : mType(other.mType),
+    mValue(std::move(other.mValue)),
+    mChildren(std::move(other.mChildren)),
+    mFilePath(other.mFilePath),
+    mFileLine(other.mFileLine),
+    mFileColumn(other.mFileColumn),
+    mChildIndex(std::move(other.mChildIndex)) {
 }
 
 SExpression::~SExpression() noexcept {
@@ -93,26 +274,27 @@ const QString& SExpression::getName() const {
   if (isList()) {
     return mValue;
   } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Node is not a list."));
+    throw FileParseError(__FILE__, __LINE__, mFilePath, mFileLine,
+                         mFileColumn, QString(), tr("Node is not a list."));
   }
 }
 
 const QString& SExpression::getStringOrToken(bool throwIfEmpty) const {
   if (!isToken() && !isString()) {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, mValue,
+    throw FileParseError(__FILE__, __LINE__, mFilePath, mFileLine,
+                         mFileColumn, mValue,
                          tr("Node is not a token or string."));
   }
   if (mValue.isEmpty() && throwIfEmpty) {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, mValue,
-                         tr("Node value is empty."));
+    throw FileParseError(__FILE__, __LINE__, mFilePath, mFileLine,
+                         mFileColumn, mValue, tr("Node value is empty."));
   }
   return mValue;
 }
 
-QList<SExpression> SExpression::getChildren(const QString& name) const
+QVector<SExpression> SExpression::getChildren(const QString& name) const
     noexcept {
-  QList<SExpression> children;
+  QVector<SExpression> children;
   foreach (const SExpression& child, mChildren) {
     if (child.isList() && (child.mValue == name)) {
       children.append(child);
@@ -123,24 +305,38 @@ QList<SExpression> SExpression::getChildren(const QString& name) const
 
 const SExpression& SExpression::getChildByIndex(int index) const {
   if ((index < 0) || index >= mChildren.count()) {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+    throw FileParseError(__FILE__, __LINE__, mFilePath, mFileLine,
+                         mFileColumn, QString(),
                          QString(tr("Child not found: %1")).arg(index));
   }
   return mChildren.at(index);
 }
 
+const SExpression* SExpression::tryGetChildByName(const QString& name) const
+    noexcept {
+  if (mChildren.count() > sChildIndexThreshold) {
+    // the index is always up to date for such lists (see #mChildIndex)
+    int index = mChildIndex.value(name, -1);
+    return (index >= 0) ? &mChildren.at(index) : nullptr;
+  } else {
+    for (const SExpression& child : mChildren) {
+      if (child.isList() && (child.mValue == name)) {
+        return &child;
+      }
+    }
+    return nullptr;
+  }
+}
+
 const SExpression* SExpression::tryGetChildByPath(const QString& path) const
     noexcept {
+  if (!path.contains('/')) {
+    return tryGetChildByName(path);  // fast path, avoids splitting the path
+  }
   const SExpression* child = this;
   foreach (const QString& name, path.split('/')) {
-    bool found = false;
-    foreach (const SExpression& childchild, child->mChildren) {
-      if (childchild.isList() && (childchild.mValue == name)) {
-        child = &childchild;
-        found = true;
-      }
-    }
-    if (!found) {
+    child = child->tryGetChildByName(name);
+    if (!child) {
       return nullptr;
     }
   }
@@ -152,7 +348,8 @@ const SExpression& SExpression::getChildByPath(const QString& path) const {
   if (child) {
     return *child;
   } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+    throw FileParseError(__FILE__, __LINE__, mFilePath, mFileLine,
+                         mFileColumn, QString(),
                          QString(tr("Child not found: %1")).arg(path));
   }
 }
@@ -163,6 +360,7 @@ const SExpression& SExpression::getChildByPath(const QString& path) const {
 
 SExpression& SExpression::appendLineBreak() {
   mChildren.append(createLineBreak());
+  updateChildIndexAfterAppend();
   return *this;
 }
 
@@ -175,6 +373,18 @@ SExpression& SExpression::appendChild(const SExpression& child,
   if (mType == Type::List) {
     if (linebreak) appendLineBreak();
     mChildren.append(child);
+    updateChildIndexAfterAppend();
+    return mChildren.last();
+  } else {
+    throw LogicError(__FILE__, __LINE__);
+  }
+}
+
+SExpression& SExpression::appendChild(SExpression&& child, bool linebreak) {
+  if (mType == Type::List) {
+    if (linebreak) appendLineBreak();
+    mChildren.append(std::move(child));
+    updateChildIndexAfterAppend();
     return mChildren.last();
   } else {
     throw LogicError(__FILE__, __LINE__);
@@ -187,20 +397,102 @@ void SExpression::removeLineBreaks() noexcept {
       mChildren.removeAt(i);
     }
   }
+  buildChildIndex();  // indices have changed
 }
 
 QString SExpression::toString(int indent) const {
+  SerializeContext ctx(nullptr);
+  serializeNode(ctx, indent);  // can throw
+  return QString::fromUtf8(ctx.buffer);
+}
+
+QByteArray SExpression::toByteArray() const {
+  SerializeContext ctx(nullptr);
+  serializeNode(ctx, 0);  // can throw
+  ctx.append('\n');
+  return ctx.buffer;
+}
+
+void SExpression::serialize(QIODevice& device) const {
+  SerializeContext ctx(&device);
+  serializeNode(ctx, 0);  // can throw
+  ctx.append('\n');
+  ctx.flush();  // can throw
+}
+
+/*******************************************************************************
+ *  Operator Overloadings
+ ******************************************************************************/
+
+SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
+  mType       = rhs.mType;
+  mValue      = rhs.mValue;
+  mChildren   = rhs.mChildren;
+  mFilePath   = rhs.mFilePath;
+  mFileLine   = rhs.mFileLine;
+  mFileColumn = rhs.mFileColumn;
+  mChildIndex = rhs.mChildIndex;
+  return *this;
+}
+
+SExpression& SExpression::operator=(SExpression&& rhs) noexcept {
+  mType       = rhs.mType;
+  mValue      = std::move(rhs.mValue);
+  mChildren   = std::move(rhs.mChildren);
+  mFilePath   = rhs.mFilePath;
+  mFileLine   = rhs.mFileLine;
+  mFileColumn = rhs.mFileColumn;
+  mChildIndex = std::move(rhs.mChildIndex);
+  return *this;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void SExpression::buildChildIndex() noexcept {
+  // Note: Deserializers typically look up many different children of the same
+  // node, so building the index once makes all lookups O(1) instead of
+  // scanning all children for every single lookup.
+  mChildIndex.clear();
+  if (mChildren.count() <= sChildIndexThreshold) {
+    return;  // small lists are searched linearly
+  }
+  mChildIndex.reserve(mChildren.count());
+  for (int i = mChildren.count() - 1; i >= 0; --i) {
+    const SExpression& child = mChildren.at(i);
+    if (child.isList()) {
+      mChildIndex.insert(child.mValue, i);  // first occurrence wins
+    }
+  }
+}
+
+void SExpression::updateChildIndexAfterAppend() noexcept {
+  const int index = mChildren.count() - 1;
+  if (index == sChildIndexThreshold) {
+    buildChildIndex();  // the list has just become large enough for an index
+  } else if (index > sChildIndexThreshold) {
+    const SExpression& child = mChildren.at(index);
+    if (child.isList() && (!mChildIndex.contains(child.mValue))) {
+      mChildIndex.insert(child.mValue, index);
+    }
+  }
+}
+
+bool SExpression::serializeNode(SerializeContext& ctx, int indent) const {
   if (mType == Type::List) {
     if (!isValidListName(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression list name: %1")).arg(mValue));
     }
-    QString str = '(' + mValue;
+    ctx.append('(');
+    ctx.appendAscii(mValue);
+    bool multiLine = false;
     for (int i = 0; i < mChildren.count(); ++i) {
       const SExpression& child = mChildren.at(i);
-      if ((!str.at(str.length() - 1).isSpace()) && (!child.isLineBreak())) {
-        str += ' ';
+      if ((!ctx.lastIsSpace) && (!child.isLineBreak())) {
+        ctx.append(' ');
       }
       bool nextChildIsLineBreak = (i < mChildren.count() - 1)
                                       ? mChildren.at(i + 1).isLineBreak()
@@ -209,58 +501,64 @@ QString SExpression::toString(int indent) const {
         if ((i > 0) && mChildren.at(i - 1).isLineBreak()) {
           // too many line breaks ;)
         } else {
-          str += '\n';
+          ctx.append('\n');
         }
-      } else {
-        str += child.toString(indent + 1);
+        multiLine = true;
+      } else if (child.serializeNode(ctx, indent + 1)) {  // can throw
+        multiLine = true;
       }
     }
-    if (isMultiLineList()) {
-      str += '\n' + QString(' ').repeated(indent);
+    if (multiLine) {
+      ctx.appendLineBreak(indent);
     }
-    return str + ')';
+    ctx.append(')');
+    ctx.flushIfNeeded();  // can throw
+    return multiLine;
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression token: %1")).arg(mValue));
     }
-    return mValue;
+    ctx.appendAscii(mValue);
+    return false;
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    ctx.append('"');
+    ctx.appendEscaped(mValue);
+    ctx.append('"');
+    return false;
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    ctx.appendLineBreak(indent);
+    return true;
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
 }
 
-/*******************************************************************************
- *  Operator Overloadings
- ******************************************************************************/
-
-SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
-  mType     = rhs.mType;
-  mValue    = rhs.mValue;
-  mChildren = rhs.mChildren;
-  mFilePath = rhs.mFilePath;
-  return *this;
-}
-
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
-
-QString SExpression::escapeString(const QString& string) const noexcept {
-  return QString::fromStdString(sexpresso::escape(string.toStdString()));
-}
-
-bool SExpression::isValidListName(const QString& name) const noexcept {
-  return QRegExp("[a-z][a-z0-9_]*").exactMatch(name);
+bool SExpression::isValidListName(const QString& name) noexcept {
+  // same as the regex "[a-z][a-z0-9_]*", but much faster
+  if (name.isEmpty()) return false;
+  for (int i = 0; i < name.length(); ++i) {
+    ushort c = name.at(i).unicode();
+    bool   valid =
+        ((c >= 'a') && (c <= 'z')) ||
+        ((i > 0) && (((c >= '0') && (c <= '9')) || (c == '_')));
+    if (!valid) return false;
+  }
+  return true;
 }
 
-bool SExpression::isValidToken(const QString& token) const noexcept {
-  return QRegExp("[a-zA-Z0-9\\.:_-]+").exactMatch(token);
+bool SExpression::isValidToken(const QString& token) noexcept {
+  // same as the regex "[a-zA-Z0-9\\.:_-]+", but much faster
+  if (token.isEmpty()) return false;
+  foreach (const QChar& qc, token) {
+    ushort c     = qc.unicode();
+    bool   valid = ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+                 ((c >= '0') && (c <= '9')) || (c == '.') || (c == ':') ||
+                 (c == '_') || (c == '-');
+    if (!valid) return false;
+  }
+  return true;
 }
 
 /*******************************************************************************
@@ -283,19 +581,157 @@ SExpression SExpression::createLineBreak() {
   return SExpression(Type::LineBreak, QString());
 }
 
+SExpression SExpression::parse(const QByteArray& content,
+                               const FilePath&   filePath) {
+  ParseContext ctx(content, filePath);
+  if (content.startsWith("\xEF\xBB\xBF")) {
+    ctx.pos += 3;  // skip UTF-8 BOM
+    ctx.lineStart = ctx.columnPos = ctx.pos;
+  }
+  skipWhitespaceAndComments(ctx);
+  if (ctx.atEnd() || (*ctx.pos != '(')) {
+    ctx.throwError(tr("File does not have exactly one root node."));
+  }
+  SExpression root = parseList(ctx);  // can throw
+  skipWhitespaceAndComments(ctx);
+  if (!ctx.atEnd()) {
+    ctx.throwError(tr("File does not have exactly one root node."), ctx.pos);
+  }
+  return root;
+}
+
 SExpression SExpression::parse(const QString& str, const FilePath& filePath) {
-  std::string     error;
-  sexpresso::Sexp tree = sexpresso::parse(str.toStdString(), error);
-  if (error.empty()) {
-    if (tree.childCount() == 1) {
-      return SExpression(tree.getChild(0), filePath);
+  return parse(str.toUtf8(), filePath);
+}
+
+/*******************************************************************************
+ *  Private Static Methods
+ ******************************************************************************/
+
+SExpression SExpression::parseList(ParseContext& ctx) {
+  Q_ASSERT((!ctx.atEnd()) && (*ctx.pos == '('));
+  const char* listStart = ctx.pos;
+  ++ctx.pos;  // skip '('
+  skipWhitespaceAndComments(ctx);
+  if (ctx.atEnd() || (*ctx.pos == '(') || (*ctx.pos == ')') ||
+      (*ctx.pos == '"')) {
+    ctx.throwError(tr("List does not have a valid name."), listStart);
+  }
+  SExpression list = parseToken(ctx);
+  list.mType       = Type::List;
+  while (true) {
+    skipWhitespaceAndComments(ctx);
+    if (ctx.atEnd()) {
+      ctx.throwError(tr("Unexpected end of file, missing ')'."));
+    }
+    switch (*ctx.pos) {
+      case ')':
+        ++ctx.pos;
+        list.buildChildIndex();  // built now, lookups must not modify the tree
+        return list;
+      case '(':
+        list.mChildren.append(parseList(ctx));  // can throw
+        break;
+      case '"':
+        list.mChildren.append(parseString(ctx));  // can throw
+        break;
+      default:
+        list.mChildren.append(parseToken(ctx));
+        break;
+    }
+  }
+}
+
+SExpression SExpression::parseToken(ParseContext& ctx) {
+  int         column = ctx.getColumn();
+  const char* start  = ctx.pos;
+  while ((!ctx.atEnd()) && (!isSExprWhitespace(*ctx.pos)) &&
+         (*ctx.pos != '(') && (*ctx.pos != ')')) {
+    ++ctx.pos;
+  }
+  return SExpression(Type::Token, ctx.intern(start, ctx.pos - start),
+                     ctx.filePath, ctx.line, column);
+}
+
+SExpression SExpression::parseString(ParseContext& ctx) {
+  Q_ASSERT((!ctx.atEnd()) && (*ctx.pos == '"'));
+  SExpression node(Type::String, QString(), ctx.filePath, ctx.line,
+                   ctx.getColumn());
+  const int   startLine      = ctx.line;
+  const char* startLineStart = ctx.lineStart;
+  const char* start          = ++ctx.pos;  // skip '"'
+  bool        needUnescape   = false;
+  for (; !ctx.atEnd(); ++ctx.pos) {
+    if (*ctx.pos == '"') {
+      break;
+    } else if (*ctx.pos == '\\') {
+      needUnescape = true;
+      ++ctx.pos;
+      if (ctx.atEnd()) break;
+    }
+    if (*ctx.pos == '\n') {
+      ctx.newLine();  // raw newlines in strings are allowed
+    }
+  }
+  if (ctx.atEnd()) {
+    // report the position where the string literal starts
+    ctx.pos       = start - 1;
+    ctx.line      = startLine;
+    ctx.lineStart = startLineStart;
+    ctx.throwError(tr("Unterminated string literal."), start - 1);
+  }
+  const char* stringEnd = ctx.pos;
+  ++ctx.pos;  // skip '"'
+  if (!needUnescape) {
+    node.mValue = QString::fromUtf8(start, stringEnd - start);
+    return node;
+  }
+  QByteArray unescaped;
+  unescaped.reserve(stringEnd - start);
+  for (const char* c = start; c < stringEnd; ++c) {
+    if (*c != '\\') {
+      unescaped.append(*c);
+      continue;
+    }
+    switch (*(++c)) {
+      case '\'': unescaped.append('\''); break;
+      case '"': unescaped.append('"'); break;
+      case '?': unescaped.append('?'); break;
+      case '\\': unescaped.append('\\'); break;
+      case 'a': unescaped.append('\a'); break;
+      case 'b': unescaped.append('\b'); break;
+      case 'f': unescaped.append('\f'); break;
+      case 'n': unescaped.append('\n'); break;
+      case 'r': unescaped.append('\r'); break;
+      case 't': unescaped.append('\t'); break;
+      case 'v': unescaped.append('\v'); break;
+      default:
+        throw FileParseError(
+            __FILE__, __LINE__, ctx.filePath, node.mFileLine, node.mFileColumn,
+            QString::fromUtf8(start - 1, stringEnd - start + 2),
+            QString(tr("Invalid escape sequence: \\%1"))
+                .arg(QString::fromUtf8(c, 1)));
+    }
+  }
+  node.mValue = QString::fromUtf8(unescaped);
+  return node;
+}
+
+void SExpression::skipWhitespaceAndComments(ParseContext& ctx) noexcept {
+  while (!ctx.atEnd()) {
+    if (*ctx.pos == '\n') {
+      ctx.newLine();
+      ++ctx.pos;
+    } else if (isSExprWhitespace(*ctx.pos)) {
+      ++ctx.pos;
+    } else if (*ctx.pos == ';') {
+      // skip comment until end of line
+      while ((!ctx.atEnd()) && (*ctx.pos != '\n')) {
+        ++ctx.pos;
+      }
     } else {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           tr("File does not have exactly one root node."));
+      break;
     }
-  } else {
-    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                         QString::fromStdString(error));
   }
 }
 
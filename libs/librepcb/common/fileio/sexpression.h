@@ -32,10 +32,6 @@
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
-namespace sexpresso {
-struct Sexp;
-}
-
 namespace librepcb {
 
 class SExpression;
@@ -72,10 +68,13 @@ public:
   // Constructors / Destructor
   SExpression() noexcept;
   SExpression(const SExpression& other) noexcept;
+  SExpression(SExpression&& other) noexcept;
   ~SExpression() noexcept;
 
   // Getters
   const FilePath& getFilePath() const noexcept { return mFilePath; }
+  int             getFileLine() const noexcept { return mFileLine; }
+  int             getFileColumn() const noexcept { return mFileColumn; }
   Type            getType() const noexcept { return mType; }
   bool            isList() const noexcept { return mType == Type::List; }
   bool            isToken() const noexcept { return mType == Type::Token; }
@@ -84,9 +83,10 @@ public:
   bool isMultiLineList() const noexcept;
   const QString&            getName() const;
   const QString&            getStringOrToken(bool throwIfEmpty = false) const;
-  const QList<SExpression>& getChildren() const { return mChildren; }
-  QList<SExpression>        getChildren(const QString& name) const noexcept;
-  const SExpression&        getChildByIndex(int index) const;
+  const QVector<SExpression>& getChildren() const { return mChildren; }
+  QVector<SExpression>        getChildren(const QString& name) const noexcept;
+  const SExpression&          getChildByIndex(int index) const;
+  const SExpression* tryGetChildByName(const QString& name) const noexcept;
   const SExpression* tryGetChildByPath(const QString& path) const noexcept;
   const SExpression& getChildByPath(const QString& path) const;
 
@@ -95,8 +95,8 @@ public:
     try {
       return deserializeFromSExpression<T>(*this, throwIfEmpty);
     } catch (const Exception& e) {
-      throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, mValue,
-                           e.getMsg());
+      throw FileParseError(__FILE__, __LINE__, mFilePath, mFileLine,
+                           mFileColumn, mValue, e.getMsg());
     }
   }
 
@@ -109,7 +109,8 @@ public:
   template <typename T>
   T getValueOfFirstChild(bool throwIfEmpty = false) const {
     if (mChildren.count() < 1) {
-      throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+      throw FileParseError(__FILE__, __LINE__, mFilePath, mFileLine,
+                           mFileColumn, QString(),
                            tr("Node does not have children."));
     }
     return mChildren.at(0).getValue<T>(throwIfEmpty);
@@ -119,6 +120,7 @@ public:
   SExpression& appendLineBreak();
   SExpression& appendList(const QString& name, bool linebreak);
   SExpression& appendChild(const SExpression& child, bool linebreak);
+  SExpression& appendChild(SExpression&& child, bool linebreak);
   template <typename T>
   SExpression& appendChild(const T& obj) {
     appendChild(serializeToSExpression(obj), false);
@@ -128,32 +130,61 @@ public:
   SExpression& appendChild(const QString& child, const T& obj, bool linebreak) {
     return appendList(child, linebreak).appendChild(obj);
   }
-  void    removeLineBreaks() noexcept;
-  QString toString(int indent) const;
+  void       removeLineBreaks() noexcept;
+  QString    toString(int indent) const;
+  QByteArray toByteArray() const;
+  void       serialize(QIODevice& device) const;
 
   // Operator Overloadings
   SExpression& operator=(const SExpression& rhs) noexcept;
+  SExpression& operator=(SExpression&& rhs) noexcept;
 
   // Static Methods
   static SExpression createList(const QString& name);
   static SExpression createToken(const QString& token);
   static SExpression createString(const QString& string);
   static SExpression createLineBreak();
+  static SExpression parse(const QByteArray& content,
+                           const FilePath&   filePath);
   static SExpression parse(const QString& str, const FilePath& filePath);
 
+private:  // Types
+  struct ParseContext;
+  struct SerializeContext;
+
 private:  // Methods
   SExpression(Type type, const QString& value);
-  SExpression(sexpresso::Sexp& sexp, const FilePath& filePath);
+  SExpression(Type type, const QString& value, const FilePath& filePath,
+              int fileLine, int fileColumn);
+
+  static SExpression parseList(ParseContext& ctx);
+  static SExpression parseToken(ParseContext& ctx);
+  static SExpression parseString(ParseContext& ctx);
+  static void        skipWhitespaceAndComments(ParseContext& ctx) noexcept;
 
-  QString escapeString(const QString& string) const noexcept;
-  bool    isValidListName(const QString& name) const noexcept;
-  bool    isValidToken(const QString& token) const noexcept;
+  void buildChildIndex() noexcept;
+  void updateChildIndexAfterAppend() noexcept;
+  bool serializeNode(SerializeContext& ctx, int indent) const;
+  static bool isValidListName(const QString& name) noexcept;
+  static bool isValidToken(const QString& token) noexcept;
 
 private:  // Data
-  Type               mType;
-  QString            mValue;  ///< either a list name, a token or a string
-  QList<SExpression> mChildren;
-  FilePath           mFilePath;
+  Type                 mType;
+  QString              mValue;  ///< either a list name, a token or a string
+  QVector<SExpression> mChildren;
+  FilePath             mFilePath;
+  int                  mFileLine;    ///< line number in file, -1 if unknown
+  int                  mFileColumn;  ///< column in file, -1 if unknown
+
+  /// Index of the first list child with a given name, only used for lists
+  /// with more than #sChildIndexThreshold children. It is kept up to date by
+  /// the parser and all modifying methods, so const lookups never modify it
+  /// (SExpression objects are shared between threads). If such a list has no
+  /// list children at all, the index is simply empty.
+  QHash<QString, int> mChildIndex;
+
+  /// Lists with more children than this get a name index
+  static constexpr int sChildIndexThreshold = 16;
 };
 
 /*******************************************************************************
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "smartsexprfile.h"
 
+#include "asyncsexprfilewriter.h"
 #include "fileutils.h"
 #include "sexpression.h"
 
@@ -32,6 +33,39 @@
  ******************************************************************************/
 namespace librepcb {
 
+/**
+ * @brief Write-only device which forwards all data to another device and
+ *        calculates its hash on the fly
+ */
+class HashingDevice final : public QIODevice {
+public:
+  explicit HashingDevice(QIODevice& target) noexcept
+    : QIODevice(), mTarget(target), mHash(QCryptographicHash::Md5) {
+    open(QIODevice::WriteOnly);
+  }
+
+  QByteArray getHash() const noexcept { return mHash.result(); }
+
+protected:
+  qint64 readData(char* data, qint64 maxSize) noexcept override {
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+  }
+
+  qint64 writeData(const char* data, qint64 maxSize) noexcept override {
+    qint64 written = mTarget.write(data, maxSize);
+    if (written > 0) {
+      mHash.addData(data, static_cast<int>(written));
+    }
+    return written;
+  }
+
+private:
+  QIODevice&         mTarget;
+  QCryptographicHash mHash;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -48,21 +82,46 @@ SmartSExprFile::~SmartSExprFile() noexcept {
  *  General Methods
  ******************************************************************************/
 
-SExpression SmartSExprFile::parseFileAndBuildDomTree() const {
-  return SExpression::parse(FileUtils::readFile(mOpenedFilePath),
-                            mOpenedFilePath);
+SExpression SmartSExprFile::parseFileAndBuildDomTree() {
+  // Parse directly from a memory mapped file if possible to avoid copying the
+  // whole file content into memory (board files can be quite large).
+  QFile file(mOpenedFilePath.toStr());
+  if ((file.size() > 0) && file.open(QIODevice::ReadOnly)) {
+    const uchar* data = file.map(0, file.size());
+    if (data) {
+      QByteArray content = QByteArray::fromRawData(
+          reinterpret_cast<const char*>(data), file.size());
+      updateHashAfterLoading(content);
+      return SExpression::parse(content, mOpenedFilePath);  // can throw
+    }
+  }
+  QByteArray content = FileUtils::readFile(mOpenedFilePath);  // can throw
+  updateHashAfterLoading(content);
+  return SExpression::parse(content, mOpenedFilePath);  // can throw
 }
 
 void SmartSExprFile::save(const SExpression& domDocument, bool toOriginal) {
-  FilePath filepath = prepareSaveAndReturnFilePath(toOriginal);  // can throw
-  QString  content  = domDocument.toString(0);                   // can throw
-  if (!content.endsWith('\n')) {
-    content.append('\n');
-  }
-  FileUtils::writeFile(filepath, content.toUtf8());  // can throw
+  FilePath    filepath = prepareSaveAndReturnFilePath(toOriginal);  // can throw
+  QByteArray& fileHash = toOriginal ? mOriginalFileHash : mBackupFileHash;
+  fileHash = writeFile(filepath, domDocument, fileHash);  // can throw
   updateMembersAfterSaving(toOriginal);
 }
 
+void SmartSExprFile::save(SExpression&& domDocument, bool toOriginal,
+                          AsyncSExprFileWriter* writer) {
+  if (!writer) {
+    save(domDocument, toOriginal);  // can throw
+  } else if (toOriginal) {
+    throw LogicError(__FILE__, __LINE__,
+                     tr("Original files cannot be saved asynchronously."));
+  } else {
+    FilePath filepath = prepareSaveAndReturnFilePath(toOriginal);  // can throw
+    writer->addFile(filepath, std::move(domDocument));             // can throw
+    mBackupFileHash.clear();  // the content is not known until it is written
+    updateMembersAfterSaving(toOriginal);
+  }
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -71,6 +130,59 @@ SmartSExprFile* SmartSExprFile::create(const FilePath& filepath) {
   return new SmartSExprFile(filepath, false, false, true);
 }
 
+void SmartSExprFile::writeFile(const FilePath&    filepath,
+                               const SExpression& domDocument) {
+  writeFile(filepath, domDocument, QByteArray());  // can throw
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void SmartSExprFile::updateHashAfterLoading(
+    const QByteArray& content) noexcept {
+  if (mIsReadOnly) {
+    return;  // the file will never be saved, so the hash is not needed
+  }
+  QByteArray hash = calcHash(content);
+  if (mOpenedFilePath == mTmpFilePath) {
+    mBackupFileHash = hash;
+  } else {
+    mOriginalFileHash = hash;
+  }
+}
+
+QByteArray SmartSExprFile::writeFile(const FilePath&    filepath,
+                                     const SExpression& domDocument,
+                                     const QByteArray&  oldHash) {
+  FileUtils::makePath(filepath.getParentDir());  // can throw
+
+  // Stream the serialized document directly into the file instead of
+  // building the whole file content in memory first.
+  QSaveFile file(filepath.toStr());
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not open or create file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
+  HashingDevice device(file);
+  domDocument.serialize(device);  // can throw
+  QByteArray newHash = device.getHash();
+  if ((!oldHash.isEmpty()) && (newHash == oldHash) &&
+      filepath.isExistingFile()) {
+    file.cancelWriting();  // content not modified -> keep the existing file
+  } else if (!file.commit()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not write to file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
+  return newHash;
+}
+
+QByteArray SmartSExprFile::calcHash(const QByteArray& content) noexcept {
+  return QCryptographicHash::hash(content, QCryptographicHash::Md5);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -34,6 +34,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class SExpression;
 
 /*******************************************************************************
@@ -48,6 +49,12 @@ class SExpression;
  * created. With #save() the DOM tree can be saved back to the S-Expressions
  * file.
  *
+ * To avoid needless file system writes, the MD5 hash of the content which was
+ * loaded from or written to the original file and the backup file is
+ * remembered. Saving a DOM tree with the same content as the existing file is
+ * then skipped. Files created with #create() have no known content, so they
+ * are always written.
+ *
  * @note See class #SmartFile for more information.
  *
  * @author ubruhin
@@ -90,11 +97,14 @@ public:
    * @return  A pointer to the created DOM tree. The caller takes the ownership
    * of the DOM document.
    */
-  SExpression parseFileAndBuildDomTree() const;
+  SExpression parseFileAndBuildDomTree();
 
   /**
    * @brief Write the S-Expressions DOM tree to the file system
    *
+   * If the file exists and contains exactly the serialized DOM tree already
+   * (according to the remembered hash), the file is not written again.
+   *
    * @param domDocument   The DOM document to save
    * @param toOriginal    Specifies whether the original or the backup file
    * should be overwritten/created.
@@ -103,6 +113,26 @@ public:
    */
   void save(const SExpression& domDocument, bool toOriginal);
 
+  /**
+   * @brief Write the S-Expressions DOM tree to the file system, optionally in
+   * the background
+   *
+   * @param domDocument   The DOM document to save (will be moved)
+   * @param toOriginal    Specifies whether the original or the backup file
+   * should be overwritten/created.
+   * @param writer        If nullptr, the file is written immediately (like
+   *                      #save(const SExpression&, bool)). Otherwise the
+   *                      document is passed to the writer and written after
+   *                      calling AsyncSExprFileWriter#start(). This is only
+   *                      supported for the backup file since the original
+   *                      files must only be written after all backup files
+   *                      were written successfully.
+   *
+   * @throw Exception If an error occurs
+   */
+  void save(SExpression&& domDocument, bool toOriginal,
+            AsyncSExprFileWriter* writer);
+
   // Operator Overloadings
   SmartSExprFile& operator=(const SmartSExprFile& rhs) = delete;
 
@@ -123,6 +153,20 @@ public:
    */
   static SmartSExprFile* create(const FilePath& filepath);
 
+  /**
+   * @brief Write a S-Expressions DOM tree to a file
+   *
+   * @note This method does not access any #SmartSExprFile object, so it is
+   * safe to call it from any thread.
+   *
+   * @param filepath      The file to write (parent directories are created)
+   * @param domDocument   The DOM document to write
+   *
+   * @throw Exception If an error occurs
+   */
+  static void writeFile(const FilePath&    filepath,
+                        const SExpression& domDocument);
+
 private:  // Methods
   /**
    * @brief Constructor to create or open a S-Expressions file
@@ -136,6 +180,28 @@ private:  // Methods
    */
   SmartSExprFile(const FilePath& filepath, bool restore, bool readOnly,
                  bool create);
+
+  /**
+   * @brief Write a DOM document to a file if its content has changed
+   *
+   * @param filepath      The file to write (parent directories are created)
+   * @param domDocument   The DOM document to write
+   * @param oldHash       Hash of the existing file content (empty if unknown)
+   *
+   * @return The hash of the written file content
+   *
+   * @throw Exception If an error occurs
+   */
+  static QByteArray writeFile(const FilePath&    filepath,
+                              const SExpression& domDocument,
+                              const QByteArray&  oldHash);
+
+  void              updateHashAfterLoading(const QByteArray& content) noexcept;
+  static QByteArray calcHash(const QByteArray& content) noexcept;
+
+private:  // Data
+  QByteArray mOriginalFileHash;  ///< Hash of the original file (if known)
+  QByteArray mBackupFileHash;    ///< Hash of the backup file (if known)
 };
 
 /*******************************************************************************
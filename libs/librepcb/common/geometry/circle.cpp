@@ -68,7 +68,7 @@ Circle::Circle(const SExpression& node)
     mIsGrabArea(false),
     mCenter(0, 0),
     mDiameter(1) {
-  if (node.getChildByIndex(0).isString()) {
+  if (!node.getChildByIndex(0).isList()) {
     mUuid = node.getChildByIndex(0).getValue<Uuid>();
   }
   if (node.tryGetChildByPath("grab_area")) {
@@ -56,6 +56,18 @@ CmdPolygonEdit::~CmdPolygonEdit() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdPolygonEdit::getMemoryUsage() const noexcept {
+  int vertices =
+      mOldPath.getVertices().capacity() + mNewPath.getVertices().capacity();
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdPolygonEdit) - sizeof(UndoCommand)) +
+         (vertices * sizeof(Vertex));
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -48,6 +48,11 @@ public:
   explicit CmdPolygonEdit(Polygon& polygon) noexcept;
   ~CmdPolygonEdit() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // Setters
   void setLayerName(const GraphicsLayerName& name, bool immediate) noexcept;
   void setLineWidth(const UnsignedLength& width, bool immediate) noexcept;
@@ -63,7 +63,7 @@ Hole::Hole(const SExpression& node)
     // backward compatibility, remove this some time!
     mDiameter = node.getValueByPath<PositiveLength>("dia");
   }
-  if (node.getChildByIndex(0).isString()) {
+  if (!node.getChildByIndex(0).isList()) {
     mUuid = node.getChildByIndex(0).getValue<Uuid>();
   }
 }
@@ -0,0 +1,161 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "pathcontainmentindex.h"
+
+#include <QtCore>
+#include <QtGui>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+PathContainmentIndex::PathContainmentIndex() noexcept {
+}
+
+PathContainmentIndex::PathContainmentIndex(
+    const QVector<Path>& paths) noexcept {
+  setPaths(paths);
+}
+
+PathContainmentIndex::~PathContainmentIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void PathContainmentIndex::setPaths(const QVector<Path>& paths) noexcept {
+  mPolygons.clear();
+  mTree.clear();
+  mPolygons.reserve(paths.count());
+  for (int i = 0; i < paths.count(); ++i) {
+    mPolygons.append(buildPolygon(paths.at(i)));
+    if (!mPolygons.last().bands.isEmpty()) {
+      mTree.insert(i, mPolygons.last().bounds);
+    }
+  }
+}
+
+bool PathContainmentIndex::contains(int index, const Point& pos) const
+    noexcept {
+  if ((index < 0) || (index >= mPolygons.count())) return false;
+  return contains(mPolygons.at(index), pos.toPxQPointF());
+}
+
+QVector<int> PathContainmentIndex::findPathsAt(const Point& pos) const
+    noexcept {
+  QPointF      posPx = pos.toPxQPointF();
+  QVector<int> indices;
+  foreach (int index, mTree.find(posPx)) {
+    if (contains(mPolygons.at(index), posPx)) {
+      indices.append(index);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+PathContainmentIndex::Polygon PathContainmentIndex::buildPolygon(
+    const Path& path) noexcept {
+  // flatten arcs with a tolerance much smaller than any relevant feature size
+  QPolygonF              points;
+  const QVector<Vertex>& vertices = path.getVertices();
+  for (int i = 0; i < vertices.count(); ++i) {
+    const Vertex& v = vertices.at(i);
+    if ((v.getAngle() != 0) && (i + 1 < vertices.count())) {
+      Path arc = Path::flatArc(v.getPos(), vertices.at(i + 1).getPos(),
+                               v.getAngle(), PositiveLength(1000));
+      for (int k = 0; k < arc.getVertices().count() - 1; ++k) {
+        points.append(arc.getVertices().at(k).getPos().toPxQPointF());
+      }
+    } else {
+      points.append(v.getPos().toPxQPointF());
+    }
+  }
+
+  Polygon polygon;
+  polygon.bounds     = points.boundingRect();
+  polygon.bandHeight = 0;
+  QVector<QLineF> edges;
+  for (int i = 0; i < points.count(); ++i) {
+    QLineF edge(points.at(i), points.at((i + 1) % points.count()));
+    if (edge.p1().y() != edge.p2().y()) {  // horizontal edges don't matter
+      edges.append(edge);
+    }
+  }
+  if (edges.isEmpty() || (polygon.bounds.height() <= 0)) {
+    return polygon;
+  }
+
+  // sort edges into bands
+  int bandCount      = qBound(1, edges.count() / 4, 1024);
+  polygon.bandHeight = polygon.bounds.height() / bandCount;
+  polygon.bands.resize(bandCount);
+  foreach (const QLineF& edge, edges) {
+    qreal top    = (qMin(edge.y1(), edge.y2()) - polygon.bounds.top());
+    qreal bottom = (qMax(edge.y1(), edge.y2()) - polygon.bounds.top());
+    int   first  = qBound(0, int(top / polygon.bandHeight), bandCount - 1);
+    int   last   = qBound(0, int(bottom / polygon.bandHeight), bandCount - 1);
+    for (int band = first; band <= last; ++band) {
+      polygon.bands[band].append(edge);
+    }
+  }
+  return polygon;
+}
+
+bool PathContainmentIndex::contains(const Polygon& polygon,
+                                    const QPointF& pos) noexcept {
+  if (polygon.bands.isEmpty()) return false;
+  if (!polygon.bounds.contains(pos)) return false;
+  int band = int((pos.y() - polygon.bounds.top()) / polygon.bandHeight);
+  band     = qBound(0, band, polygon.bands.count() - 1);
+  bool inside = false;
+  foreach (const QLineF& edge, polygon.bands.at(band)) {
+    // odd-even crossing test with a ray in positive x direction
+    if ((edge.y1() > pos.y()) != (edge.y2() > pos.y())) {
+      qreal x = edge.x1() + (pos.y() - edge.y1()) * (edge.x2() - edge.x1()) /
+                                (edge.y2() - edge.y1());
+      if (pos.x() < x) {
+        inside = !inside;
+      }
+    }
+  }
+  return inside;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PATHCONTAINMENTINDEX_H
+#define LIBREPCB_PATHCONTAINMENTINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../utils/rtree.h"
+#include "path.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class PathContainmentIndex
+ ******************************************************************************/
+
+/**
+ * @brief Fast point-in-polygon queries for a fixed list of closed paths
+ *
+ * The index is built once for a list of paths (e.g. the fragments of a plane)
+ * and then allows to determine which paths contain a given point without
+ * creating any QPainterPath. The bounding rectangles of all paths are stored
+ * in an ::librepcb::RTree, and the edges of each path are sorted into
+ * horizontal bands, so only the few edges crossing the band of the point need
+ * to be checked.
+ *
+ * Like `path.toQPainterPathPx().contains(pos)`, the odd-even fill rule is used
+ * and open paths are implicitly closed. Arc segments are flattened with a
+ * tolerance of 1 micrometer.
+ */
+class PathContainmentIndex final {
+public:
+  // Constructors / Destructor
+  PathContainmentIndex() noexcept;
+  PathContainmentIndex(const PathContainmentIndex& other) = delete;
+  explicit PathContainmentIndex(const QVector<Path>& paths) noexcept;
+  ~PathContainmentIndex() noexcept;
+
+  // Getters
+  int count() const noexcept { return mPolygons.count(); }
+
+  // General Methods
+  void         setPaths(const QVector<Path>& paths) noexcept;
+  bool         contains(int index, const Point& pos) const noexcept;
+  QVector<int> findPathsAt(const Point& pos) const noexcept;
+
+  // Operator Overloadings
+  PathContainmentIndex& operator=(const PathContainmentIndex& rhs) = delete;
+
+private:  // Types
+  struct Polygon {
+    QRectF                   bounds;
+    qreal                    bandHeight;
+    QVector<QVector<QLineF>> bands;  ///< Edges crossing each band
+  };
+
+private:  // Methods
+  static Polygon buildPolygon(const Path& path) noexcept;
+  static bool    contains(const Polygon& polygon, const QPointF& pos) noexcept;
+
+private:  // Data
+  QVector<Polygon> mPolygons;
+  RTree<int>       mTree;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PATHCONTAINMENTINDEX_H
@@ -68,7 +68,7 @@ Polygon::Polygon(const SExpression& node)
     mIsFilled(node.getValueByPath<bool>("fill")),
     mIsGrabArea(false),
     mPath() {
-  if (node.getChildByIndex(0).isString()) {
+  if (!node.getChildByIndex(0).isList()) {
     mUuid = node.getChildByIndex(0).getValue<Uuid>();
   }
   if (node.tryGetChildByPath("grab_area")) {
@@ -41,6 +41,14 @@ UndoCommand::~UndoCommand() noexcept {
   Q_ASSERT(qAbs(mRedoCount - mUndoCount) <= 1);
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 UndoCommand::getMemoryUsage() const noexcept {
+  return sizeof(UndoCommand) + (mText.capacity() * sizeof(QChar));
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
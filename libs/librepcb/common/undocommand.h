@@ -80,6 +80,16 @@ public:
    */
   bool isCurrentlyExecuted() const noexcept { return mRedoCount > mUndoCount; }
 
+  /**
+   * @brief Get an estimate of the memory used by this command [bytes]
+   *
+   * This is used by librepcb::UndoStack to limit the memory consumed by the
+   * undo history. The default implementation only accounts the command object
+   * itself and its text, so derived classes which hold large data (e.g. copies
+   * of paths) should override it and add their own allocations.
+   */
+  virtual qint64 getMemoryUsage() const noexcept;
+
   // General Methods
 
   /**
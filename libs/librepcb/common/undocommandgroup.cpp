@@ -46,6 +46,17 @@ UndoCommandGroup::~UndoCommandGroup() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 UndoCommandGroup::getMemoryUsage() const noexcept {
+  qint64 usage = UndoCommand::getMemoryUsage();
+  usage += mChilds.count() * sizeof(UndoCommand*);
+  foreach (const UndoCommand* cmd, mChilds) { usage += cmd->getMemoryUsage(); }
+  return usage;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -56,6 +56,9 @@ public:
   // Getters
   int getChildCount() const noexcept { return mChilds.count(); }
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // General Methods
 
   /**
@@ -77,7 +77,10 @@ UndoStack::UndoStack() noexcept
   : QObject(nullptr),
     mCurrentIndex(0),
     mCleanIndex(0),
-    mActiveCommandGroup(nullptr) {
+    mActiveCommandGroup(nullptr),
+    mMaxCommandCount(0),
+    mMaxMemoryUsage(0),
+    mMemoryUsage(0) {
 }
 
 UndoStack::~UndoStack() noexcept {
@@ -130,6 +133,16 @@ void UndoStack::setClean() noexcept {
   emit cleanChanged(true);
 }
 
+void UndoStack::setMaxCommandCount(int count) noexcept {
+  mMaxCommandCount = qMax(count, 0);
+  compact();
+}
+
+void UndoStack::setMaxMemoryUsage(qint64 bytes) noexcept {
+  mMaxMemoryUsage = qMax(bytes, qint64(0));
+  compact();
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -157,15 +170,25 @@ void UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
     // delete all commands above the current index (make redoing them
     // impossible)
     // --> in reverse order (from top to bottom)!
+    qint64 memoryUsage = mMemoryUsage;
     while (mCurrentIndex < mCommands.count()) {
       delete mCommands.takeLast();
+      memoryUsage -= mCommandMemoryUsages.takeLast();
     }
     Q_ASSERT(mCurrentIndex == mCommands.count());
 
     // add command to the command stack
     mCommands.append(
         cmdScopeGuard.take());  // move ownership of "cmd" to "mCommands"
+    mCommandMemoryUsages.append(cmd->getMemoryUsage());
     mCurrentIndex++;
+    setMemoryUsage(memoryUsage + mCommandMemoryUsages.last());
+
+    // drop the oldest commands if the history has become too large (not for
+    // a new command group since its size is only known when it is committed)
+    if (!forceKeepCmd) {
+      compact();
+    }
 
     // emit signals
     emit undoTextChanged(QString(tr("Undo: %1")).arg(cmd->getText()));
@@ -229,9 +252,16 @@ void UndoStack::commitCmdGroup() {
     return;
   }
 
+  // now the size of the group is known, so the limits can be checked
+  qint64 groupMemoryUsage = mActiveCommandGroup->getMemoryUsage();
+  setMemoryUsage(mMemoryUsage - mCommandMemoryUsages.last() +
+                 groupMemoryUsage);
+  mCommandMemoryUsages.last() = groupMemoryUsage;
+
   // To finish the active command group, we only need to reset the pointer to
   // the currently active command group
   mActiveCommandGroup = nullptr;
+  compact();
 
   // emit signals
   emit canUndoChanged(canUndo());
@@ -252,6 +282,7 @@ void UndoStack::abortCmdGroup() {
     mCurrentIndex--;
     delete mCommands.takeLast();  // delete and remove the aborted command group
                                   // from the stack
+    setMemoryUsage(mMemoryUsage - mCommandMemoryUsages.takeLast());
   } catch (Exception& e) {
     qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getMsg();
     throw;
@@ -329,10 +360,12 @@ void UndoStack::clear() noexcept {
   while (!mCommands.isEmpty()) {
     delete mCommands.takeLast();
   }
+  mCommandMemoryUsages.clear();
 
   mCurrentIndex       = 0;
   mCleanIndex         = 0;
   mActiveCommandGroup = nullptr;
+  setMemoryUsage(0);
 
   // emit signals
   emit undoTextChanged(tr("Undo"));
@@ -342,6 +375,44 @@ void UndoStack::clear() noexcept {
   emit cleanChanged(true);
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void UndoStack::setMemoryUsage(qint64 bytes) noexcept {
+  Q_ASSERT(bytes >= 0);
+  if (bytes != mMemoryUsage) {
+    mMemoryUsage = bytes;
+    emit memoryUsageChanged(mMemoryUsage);
+  }
+}
+
+void UndoStack::compact() noexcept {
+  // determine how many commands need to be removed from the bottom
+  int    count  = 0;
+  qint64 memory = mMemoryUsage;
+  while ((count < mCurrentIndex - 1) &&
+         (((mMaxCommandCount > 0) &&
+           (mCommands.count() - count > mMaxCommandCount)) ||
+          ((mMaxMemoryUsage > 0) && (memory > mMaxMemoryUsage)))) {
+    memory -= mCommandMemoryUsages.at(count);
+    ++count;
+  }
+  if (count == 0) {
+    return;
+  }
+
+  // delete them from bottom to top (oldest first)
+  for (int i = 0; i < count; ++i) {
+    delete mCommands.takeFirst();
+    mCommandMemoryUsages.removeFirst();
+  }
+  mCurrentIndex -= count;
+  mCleanIndex = (mCleanIndex >= count) ? (mCleanIndex - count) : -1;
+  Q_ASSERT(mCurrentIndex > 0);
+  setMemoryUsage(memory);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
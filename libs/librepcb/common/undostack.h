@@ -108,6 +108,13 @@ private:
  * successful, we should complete this documentation (explain how this feature
  * works).
  *
+ * To avoid unlimited memory growth during long editing sessions, the history
+ * can be limited by the number of commands (#setMaxCommandCount()) and/or by
+ * the estimated memory usage of the commands (#setMaxMemoryUsage(), see
+ * UndoCommand#getMemoryUsage()). If a limit is exceeded, the oldest commands
+ * are deleted automatically (but never the command on top of the undo
+ * history, so at least one step can always be undone).
+ *
  * @see #UndoCommand, #UndoCommandGroup
  *
  * @author ubruhin
@@ -180,6 +187,26 @@ public:
    */
   bool isCommandGroupActive() const noexcept;
 
+  /**
+   * @brief Get the estimated memory usage of all commands in the stack
+   *
+   * @note The children of a currently active command group are only taken
+   *       into account after the group was committed.
+   *
+   * @return Estimated memory usage [bytes] (see UndoCommand#getMemoryUsage())
+   */
+  qint64 getMemoryUsage() const noexcept { return mMemoryUsage; }
+
+  /**
+   * @brief Get the maximum number of commands in the stack (0 = unlimited)
+   */
+  int getMaxCommandCount() const noexcept { return mMaxCommandCount; }
+
+  /**
+   * @brief Get the maximum memory usage of the stack (0 = unlimited)
+   */
+  qint64 getMaxMemoryUsage() const noexcept { return mMaxMemoryUsage; }
+
   // Setters
 
   /**
@@ -187,6 +214,22 @@ public:
    */
   void setClean() noexcept;
 
+  /**
+   * @brief Set the maximum number of commands in the stack
+   *
+   * @param count   Maximum command count (0 = unlimited). If the stack
+   *                contains more commands, the oldest ones are deleted.
+   */
+  void setMaxCommandCount(int count) noexcept;
+
+  /**
+   * @brief Set the maximum memory usage of the stack
+   *
+   * @param bytes   Maximum estimated memory usage [bytes] (0 = unlimited). If
+   *                the stack uses more memory, the oldest commands are deleted.
+   */
+  void setMaxMemoryUsage(qint64 bytes) noexcept;
+
   // General Methods
 
   /**
@@ -199,7 +242,9 @@ public:
    * exception, the command will be deleted directly in this method, so you must
    * not make other things with the UndoCommand object after passing it to this
    * method.
-   * @param forceKeepCmd  Only for internal use!
+   * @param forceKeepCmd  Only for internal use! (used by #beginCmdGroup(), the
+   *                      history is then not compacted before the group is
+   *                      committed)
    *
    * @throw Exception If the command is not executed successfully, this method
    *                  throws an exception and tries to keep the state of the
@@ -293,8 +338,27 @@ signals:
   void commandGroupEnded();
   void commandGroupAborted();
   void stateModified();
+  void memoryUsageChanged(qint64 bytes);
 
-private:
+private:  // Methods
+  /**
+   * @brief Set the estimated memory usage and emit #memoryUsageChanged()
+   *
+   * The memory usage is tracked incrementally (i.e. adjusted whenever commands
+   * are added or deleted) to avoid iterating over the whole history.
+   */
+  void setMemoryUsage(qint64 bytes) noexcept;
+
+  /**
+   * @brief Delete the oldest commands until the limits are no longer exceeded
+   *
+   * Only commands below the top of the undo history are deleted, i.e. all of
+   * them are currently executed and the states before them are simply no
+   * longer reachable.
+   */
+  void compact() noexcept;
+
+private:  // Data
   /**
    * @brief This list holds all commands of the undo stack
    *
@@ -303,6 +367,15 @@ private:
    */
   QList<UndoCommand*> mCommands;
 
+  /**
+   * @brief The memory usage accounted for each command in #mCommands
+   *
+   * Commands may report a different size over their lifetime, so the amount
+   * which was added to #mMemoryUsage is memorized to subtract exactly that
+   * amount again when a command gets removed from the stack.
+   */
+  QList<qint64> mCommandMemoryUsages;
+
   /**
    * @brief This attribute holds the current position in the undo stack
    * #mCommands
@@ -328,6 +401,10 @@ private:
    * nullptr.
    */
   UndoCommandGroup* mActiveCommandGroup;
+
+  int    mMaxCommandCount;  ///< Maximum count of commands (0 = unlimited)
+  qint64 mMaxMemoryUsage;   ///< Maximum memory usage [bytes] (0 = unlimited)
+  qint64 mMemoryUsage;      ///< Estimated memory usage of all commands
 };
 
 /*******************************************************************************
@@ -0,0 +1,382 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_RTREE_H
+#define LIBREPCB_RTREE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <memory>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class RTree
+ ******************************************************************************/
+
+/**
+ * @brief A dynamic R-tree to find values by their bounding rectangles
+ *
+ * Values can be inserted, moved (by inserting them again with new bounds) and
+ * removed at any time. Looking up all values overlapping a rectangle or a point
+ * is O(log n) for evenly distributed bounds. Overflowing nodes are split with
+ * Guttman's quadratic split algorithm, underflowing nodes are dissolved and
+ * their values reinserted.
+ *
+ * Bounds are treated as closed rectangles, i.e. a point on the edge of a
+ * rectangle is considered as overlapping. Rectangles with zero width or height
+ * (e.g. a single point) are allowed.
+ *
+ * @tparam T  Type of the stored values (e.g. a pointer). Must be copyable,
+ *            default-constructible, comparable and usable as QHash key. Each
+ *            value can be stored only once.
+ */
+template <typename T>
+class RTree final {
+public:
+  // Constructors / Destructor
+  RTree() noexcept : mRoot(new Node{true, {}}) {}
+  RTree(const RTree& other) = delete;
+  ~RTree() noexcept         = default;
+
+  // Getters
+  int  count() const noexcept { return mBounds.count(); }
+  bool isEmpty() const noexcept { return mBounds.isEmpty(); }
+  bool contains(const T& value) const noexcept {
+    return mBounds.contains(value);
+  }
+  QRectF getBounds(const T& value) const noexcept {
+    return mBounds.value(value);
+  }
+
+  /**
+   * @brief Get all values whose bounds overlap a given rectangle
+   *
+   * @param rect    The rectangle to search
+   *
+   * @return All found values in unspecified order
+   */
+  QList<T> find(const QRectF& rect) const noexcept {
+    QList<T> values;
+    find(*mRoot, rect.normalized(), values);
+    return values;
+  }
+
+  /**
+   * @brief Get all values whose bounds contain a given point
+   *
+   * @param pos     The point to search
+   *
+   * @return All found values in unspecified order
+   */
+  QList<T> find(const QPointF& pos) const noexcept {
+    return find(QRectF(pos, QSizeF(0, 0)));
+  }
+
+  // General Methods
+
+  /**
+   * @brief Insert a value or update the bounds of an already inserted value
+   *
+   * @param value   The value to insert
+   * @param bounds  The bounding rectangle of the value
+   */
+  void insert(const T& value, const QRectF& bounds) noexcept {
+    remove(value);
+    Entry entry;
+    entry.bounds = bounds.normalized();
+    entry.value  = value;
+    mBounds.insert(value, entry.bounds);
+    insertEntry(std::move(entry));
+  }
+
+  /**
+   * @brief Remove a value
+   *
+   * @param value   The value to remove
+   *
+   * @return True if the value was removed, false if it was not found
+   */
+  bool remove(const T& value) noexcept {
+    auto it = mBounds.find(value);
+    if (it == mBounds.end()) {
+      return false;
+    }
+    QRectF bounds = *it;
+    mBounds.erase(it);
+    std::vector<Entry> orphans;
+    bool removed = removeEntry(*mRoot, value, bounds, orphans);
+    Q_ASSERT(removed);
+    Q_UNUSED(removed);
+    // shorten the tree if the root has only one (or no) child left
+    while ((!mRoot->leaf) && (mRoot->entries.size() <= 1)) {
+      if (mRoot->entries.empty()) {
+        mRoot.reset(new Node{true, {}});
+      } else {
+        std::unique_ptr<Node> child = std::move(mRoot->entries.front().child);
+        mRoot                       = std::move(child);
+      }
+    }
+    for (Entry& orphan : orphans) {
+      insertEntry(std::move(orphan));
+    }
+    return true;
+  }
+
+  void clear() noexcept {
+    mRoot.reset(new Node{true, {}});
+    mBounds.clear();
+  }
+
+  // Operator Overloadings
+  RTree& operator=(const RTree& rhs) = delete;
+
+private:  // Types
+  struct Node;
+  struct Entry {
+    QRectF                bounds;
+    std::unique_ptr<Node> child;  ///< nullptr in leaf nodes
+    T                     value;  ///< only valid in leaf nodes
+  };
+  struct Node {
+    bool               leaf;
+    std::vector<Entry> entries;
+  };
+
+private:  // Methods
+  void insertEntry(Entry&& entry) noexcept {
+    std::unique_ptr<Node> sibling = insertEntry(*mRoot, std::move(entry));
+    if (sibling) {
+      // root was split -> grow the tree by one level
+      std::unique_ptr<Node> newRoot(new Node{false, {}});
+      Entry                 e1, e2;
+      e1.bounds = calcBounds(*mRoot);
+      e1.child  = std::move(mRoot);
+      e2.bounds = calcBounds(*sibling);
+      e2.child  = std::move(sibling);
+      newRoot->entries.push_back(std::move(e1));
+      newRoot->entries.push_back(std::move(e2));
+      mRoot = std::move(newRoot);
+    }
+  }
+
+  /// Returns the new sibling node if the passed node had to be split
+  std::unique_ptr<Node> insertEntry(Node& node, Entry&& entry) noexcept {
+    if (node.leaf) {
+      node.entries.push_back(std::move(entry));
+    } else {
+      Entry&                subtree = chooseSubtree(node, entry.bounds);
+      std::unique_ptr<Node> sibling =
+          insertEntry(*subtree.child, std::move(entry));
+      subtree.bounds = calcBounds(*subtree.child);
+      if (sibling) {
+        Entry e;
+        e.bounds = calcBounds(*sibling);
+        e.child  = std::move(sibling);
+        node.entries.push_back(std::move(e));  // invalidates "subtree"
+      }
+    }
+    if (node.entries.size() > sMaxEntries) {
+      return split(node);
+    } else {
+      return nullptr;
+    }
+  }
+
+  Entry& chooseSubtree(Node& node, const QRectF& bounds) const noexcept {
+    Q_ASSERT(!node.entries.empty());
+    Entry* best            = nullptr;
+    qreal  bestEnlargement = 0;
+    for (Entry& e : node.entries) {
+      qreal enlargement = area(unite(e.bounds, bounds)) - area(e.bounds);
+      if ((!best) || (enlargement < bestEnlargement) ||
+          ((enlargement == bestEnlargement) &&
+           (area(e.bounds) < area(best->bounds)))) {
+        best            = &e;
+        bestEnlargement = enlargement;
+      }
+    }
+    return *best;
+  }
+
+  /// Quadratic split: Moves roughly half of the entries into a new node
+  std::unique_ptr<Node> split(Node& node) noexcept {
+    std::vector<Entry> entries = std::move(node.entries);
+    node.entries.clear();
+    std::unique_ptr<Node> sibling(new Node{node.leaf, {}});
+
+    // pick the two entries which would waste the most area as seeds
+    std::size_t seed1 = 0, seed2 = 1;
+    qreal       worstWaste = -1;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      for (std::size_t k = i + 1; k < entries.size(); ++k) {
+        qreal waste = area(unite(entries[i].bounds, entries[k].bounds)) -
+            area(entries[i].bounds) - area(entries[k].bounds);
+        if (waste > worstWaste) {
+          worstWaste = waste;
+          seed1      = i;
+          seed2      = k;
+        }
+      }
+    }
+    QRectF bounds1 = entries[seed1].bounds;
+    QRectF bounds2 = entries[seed2].bounds;
+    node.entries.push_back(std::move(entries[seed1]));
+    sibling->entries.push_back(std::move(entries[seed2]));
+    entries.erase(entries.begin() + seed2);  // seed2 > seed1
+    entries.erase(entries.begin() + seed1);
+
+    // distribute the remaining entries
+    while (!entries.empty()) {
+      // ensure that both nodes get at least the minimum number of entries
+      if (node.entries.size() + entries.size() <= sMinEntries) {
+        for (Entry& e : entries) node.entries.push_back(std::move(e));
+        break;
+      } else if (sibling->entries.size() + entries.size() <= sMinEntries) {
+        for (Entry& e : entries) sibling->entries.push_back(std::move(e));
+        break;
+      }
+      // pick the entry with the strongest preference for one of the nodes
+      std::size_t next = 0;
+      qreal       d1 = 0, d2 = 0, maxDiff = -1;
+      for (std::size_t i = 0; i < entries.size(); ++i) {
+        qreal e1 = area(unite(bounds1, entries[i].bounds)) - area(bounds1);
+        qreal e2 = area(unite(bounds2, entries[i].bounds)) - area(bounds2);
+        if (qAbs(e1 - e2) > maxDiff) {
+          maxDiff = qAbs(e1 - e2);
+          next    = i;
+          d1      = e1;
+          d2      = e2;
+        }
+      }
+      bool toFirst = (d1 < d2) ||
+          ((d1 == d2) && (area(bounds1) < area(bounds2))) ||
+          ((d1 == d2) && (area(bounds1) == area(bounds2)) &&
+           (node.entries.size() <= sibling->entries.size()));
+      if (toFirst) {
+        bounds1 = unite(bounds1, entries[next].bounds);
+        node.entries.push_back(std::move(entries[next]));
+      } else {
+        bounds2 = unite(bounds2, entries[next].bounds);
+        sibling->entries.push_back(std::move(entries[next]));
+      }
+      entries.erase(entries.begin() + next);
+    }
+    return sibling;
+  }
+
+  bool removeEntry(Node& node, const T& value, const QRectF& bounds,
+                   std::vector<Entry>& orphans) noexcept {
+    for (auto it = node.entries.begin(); it != node.entries.end(); ++it) {
+      if (node.leaf) {
+        if (it->value == value) {
+          node.entries.erase(it);
+          return true;
+        }
+      } else if (contains(it->bounds, bounds) &&
+                 removeEntry(*it->child, value, bounds, orphans)) {
+        if (it->child->entries.size() < sMinEntries) {
+          // dissolve underflowing node, its values will be reinserted
+          collectLeafEntries(*it->child, orphans);
+          node.entries.erase(it);
+        } else {
+          it->bounds = calcBounds(*it->child);
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void collectLeafEntries(Node& node,
+                                 std::vector<Entry>& entries) noexcept {
+    for (Entry& e : node.entries) {
+      if (node.leaf) {
+        entries.push_back(std::move(e));
+      } else {
+        collectLeafEntries(*e.child, entries);
+      }
+    }
+    node.entries.clear();
+  }
+
+  static void find(const Node& node, const QRectF& rect,
+                   QList<T>& values) noexcept {
+    for (const Entry& e : node.entries) {
+      if (overlaps(e.bounds, rect)) {
+        if (node.leaf) {
+          values.append(e.value);
+        } else {
+          find(*e.child, rect, values);
+        }
+      }
+    }
+  }
+
+  static QRectF calcBounds(const Node& node) noexcept {
+    QRectF bounds;
+    for (std::size_t i = 0; i < node.entries.size(); ++i) {
+      bounds = (i == 0) ? node.entries[i].bounds
+                        : unite(bounds, node.entries[i].bounds);
+    }
+    return bounds;
+  }
+
+  // Note: QRectF::united() and QRectF::intersects() ignore rectangles with
+  // zero width or height, thus we need our own implementations.
+  static QRectF unite(const QRectF& a, const QRectF& b) noexcept {
+    QPointF topLeft(qMin(a.left(), b.left()), qMin(a.top(), b.top()));
+    QPointF bottomRight(qMax(a.right(), b.right()),
+                        qMax(a.bottom(), b.bottom()));
+    return QRectF(topLeft, bottomRight);
+  }
+  static bool overlaps(const QRectF& a, const QRectF& b) noexcept {
+    return (a.left() <= b.right()) && (b.left() <= a.right()) &&
+           (a.top() <= b.bottom()) && (b.top() <= a.bottom());
+  }
+  static bool contains(const QRectF& outer, const QRectF& inner) noexcept {
+    return (outer.left() <= inner.left()) && (outer.right() >= inner.right()) &&
+           (outer.top() <= inner.top()) && (outer.bottom() >= inner.bottom());
+  }
+  static qreal area(const QRectF& r) noexcept {
+    return r.width() * r.height();
+  }
+
+private:  // Data
+  std::unique_ptr<Node> mRoot;
+  QHash<T, QRectF>      mBounds;  ///< bounds of all values, to find them again
+
+  static constexpr std::size_t sMaxEntries = 16;
+  static constexpr std::size_t sMinEntries = 6;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_RTREE_H
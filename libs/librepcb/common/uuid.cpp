@@ -22,47 +22,62 @@
  ******************************************************************************/
 #include "uuid.h"
 
-#include <QRegularExpressionValidator>
 #include <QtCore>
 
+#include <type_traits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+static_assert(sizeof(Uuid) == 16, "Uuid should be a 128 bit value");
+static_assert(std::is_trivially_copyable<Uuid>::value,
+              "Uuid should be trivially copyable");
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QString Uuid::toStr() const noexcept {
+  static const char digits[] = "0123456789abcdef";
+  QString           str(36, Qt::Uninitialized);
+  QChar*            out = str.data();
+  for (int i = 0; i < 32; ++i) {
+    if ((i == 8) || (i == 12) || (i == 16) || (i == 20)) {
+      *out++ = QLatin1Char('-');
+    }
+    quint64 bits  = (i < 16) ? mHigh : mLow;
+    int     shift = 60 - (4 * (i % 16));
+    *out++        = QLatin1Char(digits[(bits >> shift) & 0xF]);
+  }
+  return str;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
 bool Uuid::isValid(const QString& str) noexcept {
-  // check format of string (only accept EXACT matches!)
-  QRegularExpression re(
-      "^[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$");
-  QRegularExpressionMatch match =
-      re.match(str, 0, QRegularExpression::PartialPreferCompleteMatch);
-  if (!match.hasMatch()) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
-  return true;
+  quint64 high, low;
+  return parse(str, high, low);
 }
 
 Uuid Uuid::createRandom() noexcept {
   QString str =
       QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     qFatal("Not able to generate valid random UUID!");  // calls abort()!
   }
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     throw RuntimeError(
         __FILE__, __LINE__,
@@ -71,13 +86,46 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 tl::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     return tl::nullopt;
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool Uuid::parse(const QString& str, quint64& high, quint64& low) noexcept {
+  // check format of string (only accept EXACT matches!)
+  if (str.length() != 36) return false;
+  quint64 bits[2] = {0, 0};
+  int     digit   = 0;
+  for (int i = 0; i < str.length(); ++i) {
+    ushort c = str.at(i).unicode();
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      if (c != '-') return false;
+    } else if ((c >= '0') && (c <= '9')) {
+      bits[digit / 16] = (bits[digit / 16] << 4) | (c - '0');
+      ++digit;
+    } else if ((c >= 'a') && (c <= 'f')) {
+      bits[digit / 16] = (bits[digit / 16] << 4) | (c - 'a' + 10);
+      ++digit;
+    } else {
+      return false;
+    }
+  }
+
+  // check type of uuid
+  if (((bits[0] >> 12) & 0xF) != 4) return false;    // version 4 (random)
+  if (((bits[1] >> 62) & 0x3) != 0x2) return false;  // variant DCE
+  high = bits[0];
+  low  = bits[1];
+  return true;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
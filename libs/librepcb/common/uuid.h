@@ -48,6 +48,10 @@ namespace librepcb {
  *
  * A valid UUID looks like this: "d79d354b-62bd-4866-996a-78941c575e78"
  *
+ * Internally the UUID is stored as 128 bits (two 64 bit integers) instead of
+ * a string, so copying, comparing and hashing UUIDs is very cheap. The string
+ * is only created when needed (e.g. for serialization) with #toStr().
+ *
  * @note This class guarantees that only Uuid objects representing a valid UUID
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use tl::optional<librepcb::Uuid> instead.
@@ -71,7 +75,7 @@ public:
    *
    * @param other     Another #Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept = default;
 
   /**
    * @brief Destructor
@@ -85,7 +89,7 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -93,20 +97,37 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same as comparing their strings)
    */
-  Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
-    return *this;
+  Uuid& operator=(const Uuid& rhs) noexcept = default;
+  bool  operator==(const Uuid& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept { return compare(rhs) < 0; }
+  bool operator>(const Uuid& rhs) const noexcept { return compare(rhs) > 0; }
+  bool operator<=(const Uuid& rhs) const noexcept { return compare(rhs) <= 0; }
+  bool operator>=(const Uuid& rhs) const noexcept { return compare(rhs) >= 0; }
   //@}
 
+  /**
+   * @brief Three-way comparison
+   *
+   * @param rhs   The other object to compare
+   *
+   * @return A negative value if this UUID is less than rhs, zero if they are
+   *         equal, and a positive value if this UUID is greater than rhs
+   */
+  int compare(const Uuid& rhs) const noexcept {
+    if (mHigh != rhs.mHigh) {
+      return (mHigh < rhs.mHigh) ? -1 : 1;
+    } else if (mLow != rhs.mLow) {
+      return (mLow < rhs.mLow) ? -1 : 1;
+    } else {
+      return 0;
+    }
+  }
+
   // Static Methods
 
   /**
@@ -150,14 +171,33 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its binary value
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @param high      The first 64 bits of the UUID
+   * @param low       The last 64 bits of the UUID
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  Uuid(quint64 high, quint64 low) noexcept : mHigh(high), mLow(low) {}
+
+  /**
+   * @brief Parse a UUID string into its binary value
+   *
+   * @param str       The string to parse
+   * @param high      Receives the first 64 bits of the UUID
+   * @param low       Receives the last 64 bits of the UUID
+   *
+   * @retval true     If str is a valid UUID
+   * @retval false    If str is not a valid UUID
+   */
+  static bool parse(const QString& str, quint64& high, quint64& low) noexcept;
+
+private:  // Data
+  // Guaranteed to always contain a valid UUID. The first character of the
+  // string representation is stored in the most significant bits of #mHigh,
+  // thus comparing the integers gives the same result as comparing strings.
+  quint64 mHigh;  ///< The first 64 bits of the UUID
+  quint64 mLow;   ///< The last 64 bits of the UUID
 
-private:          // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 };
 
 /*******************************************************************************
@@ -208,7 +248,8 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  // random UUIDs are uniformly distributed, so just fold them together
+  return ::qHash(key.mHigh ^ key.mLow, seed);
 }
 
 /*******************************************************************************
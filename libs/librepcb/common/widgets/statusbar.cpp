@@ -48,6 +48,12 @@ StatusBar::StatusBar(QWidget* parent) noexcept
   mAbsPosYLabel->setFont(QFont("monospace"));
   addPermanentWidget(mAbsPosYLabel.data());
 
+  // memory usage of the undo stack
+  mUndoMemoryLabel.reset(new QLabel());
+  mUndoMemoryLabel->setSizePolicy(QSizePolicy::Preferred,
+                                  QSizePolicy::Preferred);
+  addPermanentWidget(mUndoMemoryLabel.data());
+
   // progress bar
   mProgressBar.reset(new QProgressBar());
   mProgressBar->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
@@ -64,6 +70,7 @@ StatusBar::StatusBar(QWidget* parent) noexcept
   // init
   setFields(0);
   setAbsoluteCursorPosition(Point());
+  setUndoMemoryUsage(0);
   setProgressBarVisible(false);
   setProgressBarPercent(0);
 }
@@ -76,8 +83,10 @@ StatusBar::~StatusBar() noexcept {
  ******************************************************************************/
 
 void StatusBar::setFields(Fields fields) noexcept {
+  mFields = fields;
   mAbsPosXLabel->setVisible(fields & AbsolutePosition);
   mAbsPosYLabel->setVisible(fields & AbsolutePosition);
+  mUndoMemoryLabel->setVisible(fields & UndoMemory);
 }
 
 void StatusBar::setField(Field field, bool enable) noexcept {
@@ -94,6 +103,11 @@ void StatusBar::setAbsoluteCursorPosition(const Point& pos) noexcept {
   mAbsPosYLabel->setText(QString("Y:%1mm").arg(pos.getY().toMm(), 12, 'f', 6));
 }
 
+void StatusBar::setUndoMemoryUsage(qint64 bytes) noexcept {
+  mUndoMemoryLabel->setText(
+      tr("Undo: %1 MB").arg(bytes / qreal(1024 * 1024), 0, 'f', 1));
+}
+
 void StatusBar::setProgressBarVisible(bool visible) noexcept {
   mProgressBar->setVisible(visible);
   mProgressBarPlaceHolder->setVisible(!visible);
@@ -51,6 +51,7 @@ public:
   enum Field {
     AbsolutePosition = 1 << 0,
     ProgressBar      = 1 << 1,
+    UndoMemory       = 1 << 2,
   };
   Q_DECLARE_FLAGS(Fields, Field);
 
@@ -69,6 +70,7 @@ public:
   void setProgressBarVisible(bool visible) noexcept;
   void setProgressBarTextFormat(const QString& format) noexcept;
   void setProgressBarPercent(int percent) noexcept;
+  void setUndoMemoryUsage(qint64 bytes) noexcept;
 
   // General Methods
   void showProgressBar() noexcept { setProgressBarVisible(true); }
@@ -81,6 +83,7 @@ private:  // Data
   Fields                       mFields;
   QScopedPointer<QLabel>       mAbsPosXLabel;
   QScopedPointer<QLabel>       mAbsPosYLabel;
+  QScopedPointer<QLabel>       mUndoMemoryLabel;
   QScopedPointer<QProgressBar> mProgressBar;
   QScopedPointer<QWidget>      mProgressBarPlaceHolder;
 };
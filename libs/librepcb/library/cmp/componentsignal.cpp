@@ -156,10 +156,8 @@ bool ComponentSignal::operator==(const ComponentSignal& rhs) const noexcept {
 
 ComponentSignal& ComponentSignal::operator=(
     const ComponentSignal& rhs) noexcept {
-  if (mUuid != rhs.mUuid) {
-    mUuid = rhs.mUuid;
-    emit edited();
-  }
+  // Note: The UUID is not copied since it must not change while the signal is
+  // contained in a SerializableObjectList (it is indexed by UUID).
   setName(rhs.mName);
   setRole(rhs.mRole);
   setForcedNetName(rhs.mForcedNetName);
@@ -89,6 +89,7 @@ public:
   bool operator!=(const ComponentSignal& rhs) const noexcept {
     return !(*this == rhs);
   }
+  /// Copies all attributes except the UUID
   ComponentSignal& operator=(const ComponentSignal& rhs) noexcept;
 
 signals:
@@ -123,7 +123,7 @@ LibraryBaseElement::LibraryBaseElement(const FilePath& elementDirectory,
   mLoadingFileDocument = sexprFile.parseFileAndBuildDomTree();
 
   // read attributes
-  if (mLoadingFileDocument.getChildByIndex(0).isString()) {
+  if (!mLoadingFileDocument.getChildByIndex(0).isList()) {
     mUuid = mLoadingFileDocument.getChildByIndex(0).getValue<Uuid>();
   } else {
     // backward compatibility, remove this some time!
@@ -30,7 +30,9 @@
 #include "boardairwiresbuilder.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
+#include "boardplanesrebuilder.h"
 #include "boardselectionquery.h"
+#include "boardspatialindex.h"
 #include "boardusersettings.h"
 #include "items/bi_airwire.h"
 #include "items/bi_device.h"
@@ -57,6 +59,7 @@
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/pkg/footprint.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -76,11 +79,13 @@ Board::Board(const Board& other, const FilePath& filepath,
     mProject(other.getProject()),
     mFilePath(filepath),
     mIsAddedToProject(false),
+    mAirWiresJobsStartQueued(false),
     mUuid(Uuid::createRandom()),
     mName(name),
     mDefaultFontFileName(other.mDefaultFontFileName) {
   try {
     mGraphicsScene.reset(new GraphicsScene());
+    mSpatialIndex.reset(new BoardSpatialIndex());
 
     // copy the other board
     mFile.reset(SmartSExprFile::create(mFilePath));
@@ -180,6 +185,7 @@ Board::Board(const Board& other, const FilePath& filepath,
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mSpatialIndex.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
@@ -191,10 +197,12 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     mProject(project),
     mFilePath(filepath),
     mIsAddedToProject(false),
+    mAirWiresJobsStartQueued(false),
     mUuid(Uuid::createRandom()),
     mName("New Board") {
   try {
     mGraphicsScene.reset(new GraphicsScene());
+    mSpatialIndex.reset(new BoardSpatialIndex());
 
     // try to open/create the board file
     if (create) {
@@ -236,7 +244,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
       // the board seems to be ready to open, so we will create all needed
       // objects
 
-      if (root.getChildByIndex(0).isString()) {
+      if (!root.getChildByIndex(0).isList()) {
         mUuid = root.getChildByIndex(0).getValue<Uuid>();
       } else {
         // backward compatibility, remove this some time!
@@ -379,6 +387,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mSpatialIndex.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
@@ -412,6 +421,7 @@ Board::~Board() noexcept {
   mGridProperties.reset();
   mLayerStack.reset();
   mFile.reset();
+  mSpatialIndex.reset();
   mGraphicsScene.reset();
 }
 
@@ -441,20 +451,38 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
   foreach (BI_NetLine* netline, getNetLinesAtScenePos(pos, nullptr, nullptr)) {
     list.append(netline);
   }
-  // footprints & pads
-  foreach (BI_Device* device, mDeviceInstances) {
-    BI_Footprint& footprint = device->getFootprint();
-    if (footprint.isSelectable() &&
-        footprint.getGrabAreaScenePx().contains(scenePosPx)) {
-      if (footprint.getIsMirrored()) {
-        list.append(&footprint);
+  // footprints, pads & texts (candidates from the spatial index, sorted by
+  // the device list to get the same order as when iterating over all devices)
+  QSet<BI_Base*>            hits;
+  QMap<Uuid, BI_Footprint*> footprints;  // key: component instance UUID
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if ((!item->isSelectable()) ||
+        (!item->getGrabAreaScenePx().contains(scenePosPx))) {
+      continue;
+    }
+    BI_Footprint* footprint = nullptr;
+    if (item->getType() == BI_Base::Type_t::Footprint) {
+      footprint = static_cast<BI_Footprint*>(item);
+    } else if (item->getType() == BI_Base::Type_t::FootprintPad) {
+      footprint = &static_cast<BI_FootprintPad*>(item)->getFootprint();
+    } else if (item->getType() == BI_Base::Type_t::StrokeText) {
+      footprint = static_cast<BI_StrokeText*>(item)->getFootprint();
+    }
+    hits.insert(item);
+    if (footprint) {
+      footprints.insert(footprint->getComponentInstanceUuid(), footprint);
+    }
+  }
+  foreach (BI_Footprint* footprint, footprints) {
+    if (hits.contains(footprint)) {
+      if (footprint->getIsMirrored()) {
+        list.append(footprint);
       } else {
-        list.prepend(&footprint);
+        list.prepend(footprint);
       }
     }
-    foreach (BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(scenePosPx)) {
+    foreach (BI_FootprintPad* pad, footprint->getPads()) {
+      if (hits.contains(pad)) {
         if (pad->getIsMirrored()) {
           list.append(pad);
         } else {
@@ -462,9 +490,8 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
         }
       }
     }
-    foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
-      if (text->isSelectable() &&
-          text->getGrabAreaScenePx().contains(scenePosPx)) {
+    foreach (BI_StrokeText* text, footprint->getStrokeTexts()) {
+      if (hits.contains(text)) {
         if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
           list.prepend(text);
         } else {
@@ -489,8 +516,7 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
   }
   // texts
   foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelectable() &&
-        text->getGrabAreaScenePx().contains(scenePosPx)) {
+    if (hits.contains(text)) {
       list.append(text);
     }
   }
@@ -507,10 +533,16 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
 QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
                                         const NetSignal* netsignal) const
     noexcept {
+  QPointF        scenePosPx = pos.toPxQPointF();
   QList<BI_Via*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getViasAtScenePos(pos, list);
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::Via) {
+      BI_Via* via = static_cast<BI_Via*>(item);
+      if (via->isSelectable() &&
+          via->getGrabAreaScenePx().contains(scenePosPx) &&
+          ((!netsignal) || (&via->getNetSignalOfNetSegment() == netsignal))) {
+        list.append(via);
+      }
     }
   }
   return list;
@@ -519,10 +551,18 @@ QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF             scenePosPx = pos.toPxQPointF();
   QList<BI_NetPoint*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetPointsAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::NetPoint) {
+      BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+      if (netpoint->isSelectable() &&
+          netpoint->getGrabAreaScenePx().contains(scenePosPx) &&
+          ((!layer) || (netpoint->getLayerOfLines() == layer)) &&
+          ((!netsignal) ||
+           (&netpoint->getNetSignalOfNetSegment() == netsignal))) {
+        list.append(netpoint);
+      }
     }
   }
   return list;
@@ -531,10 +571,18 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF            scenePosPx = pos.toPxQPointF();
   QList<BI_NetLine*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetLinesAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::NetLine) {
+      BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+      if (netline->isSelectable() &&
+          netline->getGrabAreaScenePx().contains(scenePosPx) &&
+          ((!layer) || (&netline->getLayer() == layer)) &&
+          ((!netsignal) ||
+           (&netline->getNetSignalOfNetSegment() == netsignal))) {
+        list.append(netline);
+      }
     }
   }
   return list;
@@ -543,11 +591,13 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF                 scenePosPx = pos.toPxQPointF();
   QList<BI_FootprintPad*> list;
-  foreach (BI_Device* device, mDeviceInstances) {
-    foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::FootprintPad) {
+      BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
       if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
+          pad->getGrabAreaScenePx().contains(scenePosPx) &&
           ((!layer) || (pad->isOnLayer(layer->getName()))) &&
           ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
         list.append(pad);
@@ -684,12 +734,8 @@ void Board::removePlane(BI_Plane& plane) {
 }
 
 void Board::rebuildAllPlanes() noexcept {
-  QList<BI_Plane*> planes = mPlanes;
-  qSort(planes.begin(), planes.end(),
-        [](const BI_Plane* p1, const BI_Plane* p2) {
-          return !(*p1 < *p2);
-        });  // sort by priority (highest priority first)
-  foreach (BI_Plane* plane, planes) { plane->rebuild(); }
+  BoardPlanesRebuilder rebuilder(*this);
+  rebuilder.rebuildAllPlanes();
 }
 
 /*******************************************************************************
@@ -766,25 +812,16 @@ void Board::triggerAirWiresRebuild() noexcept {
 
   try {
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
-        airWire->removeFromBoard();  // can throw
-        delete airWire;
-      }
-
+      // calculate new airwires
+      QVector<QPair<Point, Point>> airwires;
       if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder         builder(*this, *netsignal);
-        QVector<QPair<Point, Point>> airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, points.first, points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.take());
-        }
+        BoardAirWiresBuilder builder(*this, *netsignal);
+        airwires = builder.buildAirWires();
       }
+      updateAirWires(netsignal, airwires);  // can throw
+      // results of running asynchronous jobs are outdated now
+      ++mAirWiresRequestIds[netsignal];
+      mPendingAirWiresJobs.remove(netsignal);
     }
     mScheduledNetSignalsForAirWireRebuild.clear();
   } catch (const std::exception&
@@ -793,6 +830,139 @@ void Board::triggerAirWiresRebuild() noexcept {
   }
 }
 
+void Board::triggerAirWiresRebuildAsync() noexcept {
+  if (!mIsAddedToProject) {
+    return;
+  }
+
+  // Coalesce requests: The jobs are started from the event loop, and nets with
+  // a running job are calculated again only as soon as that job is finished.
+  // So all requests in between result in only one job using the latest state.
+  mPendingAirWiresJobs.unite(mScheduledNetSignalsForAirWireRebuild);
+  mScheduledNetSignalsForAirWireRebuild.clear();
+  if (!mAirWiresJobsStartQueued) {
+    mAirWiresJobsStartQueued = true;
+    QTimer::singleShot(0, this, [this]() { startPendingAirWiresJobs(); });
+  }
+}
+
+void Board::updateAirWires(NetSignal*                          netsignal,
+                           const QVector<QPair<Point, Point>>& airwires) {
+  // Airwires which did not change are kept as-is, and the remaining existing
+  // airwires are moved to the new positions instead of re-creating them. This
+  // avoids lots of (de)allocations of graphics items e.g. while dragging.
+  QMultiHash<QPair<Point, Point>, BI_AirWire*> unused;
+  foreach (BI_AirWire* airWire, mAirWires.values(netsignal)) {
+    unused.insert(qMakePair(airWire->getP1(), airWire->getP2()), airWire);
+  }
+  mAirWires.remove(netsignal);
+  QVector<QPair<Point, Point>> added;
+  foreach (const auto& points, airwires) {
+    auto it = unused.find(points);
+    if (it != unused.end()) {
+      mAirWires.insertMulti(netsignal, it.value());
+      unused.erase(it);
+    } else {
+      added.append(points);
+    }
+  }
+  foreach (const auto& points, added) {
+    if (!unused.isEmpty()) {
+      BI_AirWire* airWire = unused.begin().value();
+      unused.erase(unused.begin());
+      airWire->setPoints(points.first, points.second);
+      mAirWires.insertMulti(netsignal, airWire);
+    } else {
+      QScopedPointer<BI_AirWire> airWire(
+          new BI_AirWire(*this, *netsignal, points.first, points.second));
+      airWire->addToBoard();  // can throw
+      mAirWires.insertMulti(netsignal, airWire.take());
+    }
+  }
+  foreach (BI_AirWire* airWire, unused) {
+    airWire->removeFromBoard();  // can throw
+    delete airWire;
+  }
+  emit airWiresUpdated(netsignal);
+}
+
+void Board::startPendingAirWiresJobs() noexcept {
+  mAirWiresJobsStartQueued = false;
+  if (!mIsAddedToProject) {
+    mPendingAirWiresJobs.clear();
+    return;
+  }
+
+  foreach (NetSignal* netsignal, mPendingAirWiresJobs) {
+    if (!mRunningAirWiresJobs.contains(netsignal)) {
+      mPendingAirWiresJobs.remove(netsignal);
+      startAirWiresJob(netsignal);
+    }
+  }
+}
+
+void Board::startAirWiresJob(NetSignal* netsignal) noexcept {
+  quint64 requestId = ++mAirWiresRequestIds[netsignal];
+  if ((!netsignal) || (!netsignal->isAddedToCircuit())) {
+    airWiresJobFinished(netsignal, requestId, {});  // remove airwires
+    return;
+  }
+
+  // take the snapshot in the main thread, calculate the MST in a worker
+  BoardAirWiresBuilder::Snapshot snapshot =
+      BoardAirWiresBuilder(*this, *netsignal).createSnapshot();
+  QPointer<NetSignal> guard(netsignal);
+  auto watcher = new QFutureWatcher<QVector<QPair<Point, Point>>>(this);
+  connect(watcher, &QFutureWatcherBase::finished, this,
+          [this, watcher, guard, netsignal, requestId]() {
+            if (guard) {
+              airWiresJobFinished(netsignal, requestId, watcher->result());
+            } else {  // net signal was deleted in the meantime
+              mRunningAirWiresJobs.remove(netsignal);
+              mPendingAirWiresJobs.remove(netsignal);
+            }
+            watcher->deleteLater();
+          });
+  mRunningAirWiresJobs.insert(netsignal);
+  watcher->setFuture(
+      QtConcurrent::run([snapshot]() -> QVector<QPair<Point, Point>> {
+        try {
+          return BoardAirWiresBuilder::buildAirWires(snapshot);
+        } catch (const std::exception& e) {
+          qCritical() << "Failed to build airwires:" << e.what();
+          return QVector<QPair<Point, Point>>();
+        }
+      }));
+}
+
+void Board::airWiresJobFinished(
+    NetSignal* netsignal, quint64 requestId,
+    const QVector<QPair<Point, Point>>& airwires) noexcept {
+  mRunningAirWiresJobs.remove(netsignal);
+  if (!mIsAddedToProject) {
+    mPendingAirWiresJobs.remove(netsignal);
+    return;
+  }
+
+  // discard outdated results (e.g. after a synchronous rebuild)
+  if (requestId == mAirWiresRequestIds.value(netsignal)) {
+    try {
+      if (netsignal && netsignal->isAddedToCircuit()) {
+        updateAirWires(netsignal, airwires);  // can throw
+      } else {
+        updateAirWires(netsignal, {});  // can throw
+      }
+    } catch (const Exception& e) {
+      qCritical() << "Failed to update airwires:" << e.getMsg();
+    }
+  }
+
+  // start the next job if the net signal has changed in the meantime
+  if (mPendingAirWiresJobs.remove(netsignal)) {
+    startAirWiresJob(netsignal);
+  }
+}
+
 void Board::forceAirWiresRebuild() noexcept {
   mScheduledNetSignalsForAirWireRebuild.unite(
       mProject.getCircuit().getNetSignals().values().toSet());
@@ -837,14 +1007,15 @@ void Board::removeFromProject() {
   sgl.dismiss();
 }
 
-bool Board::save(bool toOriginal, QStringList& errors) noexcept {
+bool Board::save(bool toOriginal, QStringList& errors,
+                 AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   // save board file
   try {
     if (mIsAddedToProject) {
       SExpression doc(serializeToDomElement("librepcb_board"));
-      mFile->save(doc, toOriginal);
+      mFile->save(std::move(doc), toOriginal, writer);
     } else {
       mFile->removeFile(toOriginal);
     }
@@ -854,7 +1025,7 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept {
   }
 
   // save user settings
-  if (!mUserSettings->save(toOriginal, errors)) {
+  if (!mUserSettings->save(toOriginal, errors, writer)) {
     success = false;
   }
 
@@ -870,24 +1041,33 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    QSet<BI_Base*> candidates =
+        mSpatialIndex->getItemsIn(rectPx).toSet();  // indexed items only
+    auto intersects = [&](BI_Base* item) {
+      return candidates.contains(item) && item->isSelectable() &&
+             item->getGrabAreaScenePx().intersects(rectPx);
+    };
     foreach (BI_Device* component, mDeviceInstances) {
       BI_Footprint& footprint       = component->getFootprint();
-      bool          selectFootprint = footprint.isSelectable() &&
-                             footprint.getGrabAreaScenePx().intersects(rectPx);
+      bool          selectFootprint = intersects(&footprint);
       footprint.setSelected(selectFootprint);
       foreach (BI_FootprintPad* pad, footprint.getPads()) {
-        bool selectPad =
-            pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-        pad->setSelected(selectFootprint || selectPad);
+        pad->setSelected(selectFootprint || intersects(pad));
       }
       foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
-        bool selectText = text->isSelectable() &&
-                          text->getGrabAreaScenePx().intersects(rectPx);
-        text->setSelected(selectFootprint || selectText);
+        text->setSelected(selectFootprint || intersects(text));
       }
     }
     foreach (BI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
+      foreach (BI_Via* via, segment->getVias()) {
+        via->setSelected(intersects(via));
+      }
+      foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
+        netpoint->setSelected(intersects(netpoint));
+      }
+      foreach (BI_NetLine* netline, segment->getNetLines()) {
+        netline->setSelected(intersects(netline));
+      }
     }
     foreach (BI_Plane* plane, mPlanes) {
       bool select = plane->isSelectable() &&
@@ -900,9 +1080,7 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
       polygon->setSelected(select);
     }
     foreach (BI_StrokeText* text, mStrokeTexts) {
-      bool select =
-          text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-      text->setSelected(select);
+      text->setSelected(intersects(text));
     }
     foreach (BI_Hole* hole, mHoles) {
       bool select =
@@ -46,6 +46,7 @@ namespace librepcb {
 class GridProperties;
 class GraphicsView;
 class GraphicsScene;
+class AsyncSExprFileWriter;
 class SmartSExprFile;
 class GraphicsLayer;
 class BoardDesignRules;
@@ -70,6 +71,7 @@ class BoardLayerStack;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
 class BoardSelectionQuery;
+class BoardSpatialIndex;
 
 /*******************************************************************************
  *  Class Board
@@ -133,6 +135,7 @@ public:
     return *mGridProperties;
   }
   GraphicsScene&   getGraphicsScene() const noexcept { return *mGraphicsScene; }
+  BoardSpatialIndex& getSpatialIndex() const noexcept { return *mSpatialIndex; }
   BoardLayerStack& getLayerStack() noexcept { return *mLayerStack; }
   const BoardLayerStack& getLayerStack() const noexcept { return *mLayerStack; }
   BoardDesignRules&      getDesignRules() noexcept { return *mDesignRules; }
@@ -215,16 +218,21 @@ public:
   void                   removeHole(BI_Hole& hole);
 
   // AirWire Methods
+  const QMultiHash<NetSignal*, BI_AirWire*>& getAirWires() const noexcept {
+    return mAirWires;
+  }
   void scheduleAirWiresRebuild(NetSignal* netsignal) noexcept {
     mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
   }
   void triggerAirWiresRebuild() noexcept;
+  void triggerAirWiresRebuildAsync() noexcept;
   void forceAirWiresRebuild() noexcept;
 
   // General Methods
   void addToProject();
   void removeFromProject();
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
   void showInView(GraphicsView& view) noexcept;
   void saveViewSceneRect(const QRectF& rect) noexcept { mViewRect = rect; }
   const QRectF& restoreViewSceneRect() const noexcept { return mViewRect; }
@@ -256,11 +264,19 @@ signals:
 
   void deviceAdded(BI_Device& comp);
   void deviceRemoved(BI_Device& comp);
+  void airWiresUpdated(NetSignal* netsignal);
 
 private:
   Board(Project& project, const FilePath& filepath, bool restore, bool readOnly,
         bool create, const QString& newName);
   void updateIcon() noexcept;
+  void updateAirWires(NetSignal*                          netsignal,
+                      const QVector<QPair<Point, Point>>& airwires);
+  void startPendingAirWiresJobs() noexcept;
+  void startAirWiresJob(NetSignal* netsignal) noexcept;
+  void airWiresJobFinished(
+      NetSignal* netsignal, quint64 requestId,
+      const QVector<QPair<Point, Point>>& airwires) noexcept;
   void updateErcMessages() noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
@@ -273,6 +289,7 @@ private:
   bool                           mIsAddedToProject;
 
   QScopedPointer<GraphicsScene>                  mGraphicsScene;
+  QScopedPointer<BoardSpatialIndex>              mSpatialIndex;
   QScopedPointer<BoardLayerStack>                mLayerStack;
   QScopedPointer<GridProperties>                 mGridProperties;
   QScopedPointer<BoardDesignRules>               mDesignRules;
@@ -281,6 +298,12 @@ private:
   QRectF                                         mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
 
+  // Asynchronous airwire calculation
+  QHash<NetSignal*, quint64> mAirWiresRequestIds;  ///< Latest request per net
+  QSet<NetSignal*>           mRunningAirWiresJobs;
+  QSet<NetSignal*>           mPendingAirWiresJobs;  ///< Not started yet
+  bool                       mAirWiresJobsStartQueued;
+
   // Attributes
   Uuid        mUuid;
   ElementName mName;
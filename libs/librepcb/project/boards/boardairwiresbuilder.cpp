@@ -37,112 +37,75 @@
 #include <delaunay-triangulation/delaunay.h>
 #include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/library/pkg/footprintpad.h>
-#include <unordered_map>
 
 #include <QtCore>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
-// adapted from horizon/kicad
-static QVector<QPair<Point, Point>> kruskalMst(
-    std::vector<delaunay::Edge<qreal>>&    aEdges,
-    std::vector<delaunay::Vector2<qreal>>& aNodes) noexcept {
-  unsigned int nodeNumber      = aNodes.size();
-  unsigned int mstExpectedSize = nodeNumber - 1;
-  unsigned int mstSize         = 0;
-  bool         ratsnestLines   = false;
-
-  // printf("mst nodes : %d edges : %d\n", aNodes.size(), aEdges.size () );
-  // The output
-  QVector<QPair<Point, Point>> mst;
-
-  // Set tags for marking cycles
-  std::unordered_map<int, int> tags;
-  unsigned int                 tag = 0;
-
-  for (auto& node : aNodes) {
-    node.tag      = tag;
-    tags[node.id] = tag++;
+/**
+ * @brief Disjoint-set forest with union by rank and path halving
+ */
+class UnionFind final {
+public:
+  explicit UnionFind(int size) noexcept : mParents(size), mRanks(size, 0) {
+    std::iota(mParents.begin(), mParents.end(), 0);
   }
 
-  // Lists of nodes connected together (subtrees) to detect cycles in the
-  // graph
-  std::vector<std::list<int>> cycles(nodeNumber);
-
-  for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
-
-  // Kruskal algorithm requires edges to be sorted by their weight
-  std::sort(aEdges.begin(), aEdges.end(),
-            [](const delaunay::Edge<qreal>& a, const delaunay::Edge<qreal>& b) {
-              return a.weight > b.weight;
-            });
-
-  while (mstSize < mstExpectedSize && !aEdges.empty()) {
-    auto& dt = aEdges.back();
-
-    int srcTag = tags[dt.p1.id];
-    int trgTag = tags[dt.p2.id];
-    // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-    // dt.weight, srcTag, trgTag);
-
-    // Check if by adding this edge we are going to join two different
-    // forests
-    if (srcTag != trgTag) {
-      // Because edges are sorted by their weight, first we always process
-      // connected
-      // items (weight == 0). Once we stumble upon an edge with non-zero
-      // weight,
-      // it means that the rest of the lines are ratsnest.
-      if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
+  int find(int i) noexcept {
+    while (mParents[i] != i) {
+      mParents[i] = mParents[mParents[i]];
+      i           = mParents[i];
+    }
+    return i;
+  }
 
-      // Update tags
-      if (ratsnestLines) {
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[aNodes[*it].id] = srcTag;
-        }
+  bool unite(int a, int b) noexcept {
+    a = find(a);
+    b = find(b);
+    if (a == b) return false;
+    if (mRanks[a] < mRanks[b]) std::swap(a, b);
+    mParents[b] = a;
+    if (mRanks[a] == mRanks[b]) ++mRanks[a];
+    return true;
+  }
 
-        // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-        // RN_EDGE,
-        // RN_EDGE_MST saves both source and target node and does not
-        // require any other
-        // edges to exist for getting source/target nodes
-        // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-        // dt.GetWeight() );
+private:
+  std::vector<int> mParents;
+  std::vector<int> mRanks;
+};
 
-        // assert( newEdge.GetSourceNode()->GetTag() !=
-        // newEdge.GetTargetNode()->GetTag() );
-        // assert(dt.p1.tag != dt.p2.tag);
-        mst.append(qMakePair(Point(dt.p1.x, dt.p1.y), Point(dt.p2.x, dt.p2.y)));
-        ++mstSize;
-      } else {
-        // for( it = cycles[trgTag].begin(), itEnd =
-        // cycles[trgTag].end(); it != itEnd; ++it )
-        // for( auto it : cycles[trgTag] )
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[aNodes[*it].id] = srcTag;
-          aNodes[*it].tag      = srcTag;
-        }
+static QVector<QPair<Point, Point>> kruskalMst(
+    std::vector<delaunay::Edge<qreal>>& edges, int nodeCount) noexcept {
+  // Kruskal algorithm requires edges to be sorted by their weight. Since
+  // already connected items have a negative weight, they are processed first
+  // and only join their subtrees. All other edges are airwires.
+  std::stable_sort(
+      edges.begin(), edges.end(),
+      [](const delaunay::Edge<qreal>& a, const delaunay::Edge<qreal>& b) {
+        return a.weight < b.weight;
+      });
 
-        // Processing a connection, decrease the expected size of the
-        // ratsnest MST
-        --mstExpectedSize;
+  QVector<QPair<Point, Point>> mst;
+  UnionFind                    forest(nodeCount);
+  int                          subtrees = nodeCount;
+  for (const delaunay::Edge<qreal>& edge : edges) {
+    if (subtrees <= 1) break;
+    if (forest.unite(edge.p1.id, edge.p2.id)) {
+      --subtrees;
+      if (edge.weight >= 0) {
+        mst.append(qMakePair(Point(edge.p1.x, edge.p1.y),
+                             Point(edge.p2.x, edge.p2.y)));
       }
-
-      // Move nodes that were marked with old tag to the list marked with
-      // the new tag
-      cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
     }
-
-    // Remove the edge that was just processed
-    aEdges.pop_back();
   }
-
   return mst;
 }
 
@@ -162,26 +125,23 @@ BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
  *  General Methods
  ******************************************************************************/
 
-QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
-  std::vector<delaunay::Vector2<qreal>> points;
-  QHash<const BI_NetLineAnchor*, int>   anchorMap;
-  QHash<int, QString>                   layerMap;
-  std::vector<delaunay::Edge<qreal>>    edges;
+BoardAirWiresBuilder::Snapshot BoardAirWiresBuilder::createSnapshot() const {
+  Snapshot                            snapshot;
+  QHash<const BI_NetLineAnchor*, int> anchorMap;
+  QVector<QString>                    layers;  // null string = all layers
 
   // pads
   foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
       if (&pad->getBoard() != &mBoard) continue;
-      int   id  = points.size();
-      Point pos = pad->getPosition();
-      points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-      anchorMap[pad] = id;
+      anchorMap[pad] = snapshot.points.count();
+      snapshot.points.append(pad->getPosition());
       if (pad->getLibPad().getBoardSide() ==
           library::FootprintPad::BoardSide::THT) {
-        layerMap[id] = QString();  // on all layers
+        layers.append(QString());  // on all layers
       } else {
-        layerMap[id] = pad->getLayerName();
+        layers.append(pad->getLayerName());
       }
     }
   }
@@ -192,28 +152,25 @@ QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
     if (&netsegment->getBoard() != &mBoard) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      int   id  = points.size();
-      Point pos = via->getPosition();
-      points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-      anchorMap[via] = id;
-      layerMap[id]   = QString();  // on all layers
+      anchorMap[via] = snapshot.points.count();
+      snapshot.points.append(via->getPosition());
+      layers.append(QString());  // on all layers
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const GraphicsLayer* layer = netpoint->getLayerOfLines()) {
-        int   id  = points.size();
-        Point pos = netpoint->getPosition();
-        points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-        anchorMap[netpoint] = id;
-        layerMap[id]        = layer->getName();
+        anchorMap[netpoint] = snapshot.points.count();
+        snapshot.points.append(netpoint->getPosition());
+        layers.append(layer->getName());
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
       Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
       Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      edges.emplace_back(points[anchorMap[&netline->getStartPoint()]],
-                         points[anchorMap[&netline->getEndPoint()]], -1);
+      snapshot.connections.append(
+          qMakePair(anchorMap.value(&netline->getStartPoint()),
+                    anchorMap.value(&netline->getEndPoint())));
     }
   }
 
@@ -221,23 +178,43 @@ QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
   foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
     Q_ASSERT(plane);
     if (&plane->getBoard() != &mBoard) continue;
-    foreach (const Path& fragment, plane->getFragments()) {
-      int lastId = -1;
-      for (const auto& point : points) {
-        QString pointLayer = layerMap[point.id];
-        if (pointLayer.isNull() || (pointLayer == plane->getLayerName())) {
-          Point p(point.x, point.y);
-          if (fragment.toQPainterPathPx().contains(p.toPxQPointF())) {
-            if (lastId >= 0) {
-              edges.emplace_back(points[lastId], points[point.id], -1);
-            }
-            lastId = point.id;
+    // remember the last found point of each fragment
+    const PathContainmentIndex& index = plane->getFragmentsIndex();
+    QVector<int>                lastIds(index.count(), -1);
+    for (int id = 0; id < snapshot.points.count(); ++id) {
+      const QString& layer = layers.at(id);
+      if (layer.isNull() || (layer == plane->getLayerName())) {
+        foreach (int fragment, index.findPathsAt(snapshot.points.at(id))) {
+          if (lastIds[fragment] >= 0) {
+            snapshot.connections.append(qMakePair(lastIds[fragment], id));
           }
+          lastIds[fragment] = id;
         }
       }
     }
   }
 
+  return snapshot;
+}
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
+  return buildAirWires(createSnapshot());
+}
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires(
+    const Snapshot& snapshot) {
+  std::vector<delaunay::Vector2<qreal>> points;
+  std::vector<delaunay::Edge<qreal>>    edges;
+  points.reserve(snapshot.points.count());
+  for (int id = 0; id < snapshot.points.count(); ++id) {
+    const Point& pos = snapshot.points.at(id);
+    points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
+  }
+  foreach (const auto& connection, snapshot.connections) {
+    edges.emplace_back(points[connection.first], points[connection.second],
+                       -1);
+  }
+
   // remember how many edges are already known as connected
   uint connectedEdges = edges.size();
 
@@ -256,7 +233,7 @@ QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
   }
 
   // find airwires in list of edges
-  return kruskalMst(edges, points);
+  return kruskalMst(edges, points.size());
 }
 
 /*******************************************************************************
@@ -45,6 +45,20 @@ class Board;
  */
 class BoardAirWiresBuilder final {
 public:
+  // Types
+
+  /**
+   * @brief Positions of all anchors of a net signal and the already existing
+   *        connections (netlines, planes) between them
+   *
+   * A snapshot doesn't reference any board items, so it can safely be passed
+   * to another thread for calculating the airwires.
+   */
+  struct Snapshot {
+    QVector<Point>           points;
+    QVector<QPair<int, int>> connections;  ///< Indices of connected points
+  };
+
   // Constructors / Destructor
   BoardAirWiresBuilder()                                  = delete;
   BoardAirWiresBuilder(const BoardAirWiresBuilder& other) = delete;
@@ -52,7 +66,9 @@ public:
   ~BoardAirWiresBuilder() noexcept;
 
   // General Methods
-  QVector<QPair<Point, Point>> buildAirWires() const;
+  Snapshot                            createSnapshot() const;
+  QVector<QPair<Point, Point>>        buildAirWires() const;
+  static QVector<QPair<Point, Point>> buildAirWires(const Snapshot& snapshot);
 
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
@@ -56,6 +56,7 @@ BoardFabricationOutputSettings::BoardFabricationOutputSettings() noexcept
     mSilkscreenLayersBot(
         {GraphicsLayer::sBotPlacement, GraphicsLayer::sBotNames}),
     mMergeDrillFiles(false),
+    mOptimizeDrillPath(false),
     mEnableSolderPasteTop(false),
     mEnableSolderPasteBot(false) {
 }
@@ -90,6 +91,9 @@ BoardFabricationOutputSettings::BoardFabricationOutputSettings(
   mMergeDrillFiles      = node.getValueByPath<bool>("drills/merge");
   mEnableSolderPasteTop = node.getValueByPath<bool>("solderpaste_top/create");
   mEnableSolderPasteBot = node.getValueByPath<bool>("solderpaste_bot/create");
+  if (node.tryGetChildByPath("drills/optimize_path")) {
+    mOptimizeDrillPath = node.getValueByPath<bool>("drills/optimize_path");
+  }
 
   mSilkscreenLayersTop.clear();
   foreach (const SExpression& child,
@@ -142,6 +146,7 @@ void BoardFabricationOutputSettings::serialize(SExpression& root) const {
 
   SExpression& drills = root.appendList("drills", true);
   drills.appendChild("merge", mMergeDrillFiles, false);
+  drills.appendChild("optimize_path", mOptimizeDrillPath, false);
   drills.appendChild("suffix_pth", mSuffixDrillsPth, true);
   drills.appendChild("suffix_npth", mSuffixDrillsNpth, true);
   drills.appendChild("suffix_merged", mSuffixDrills, true);
@@ -178,6 +183,7 @@ BoardFabricationOutputSettings& BoardFabricationOutputSettings::operator=(
   mSilkscreenLayersTop  = rhs.mSilkscreenLayersTop;
   mSilkscreenLayersBot  = rhs.mSilkscreenLayersBot;
   mMergeDrillFiles      = rhs.mMergeDrillFiles;
+  mOptimizeDrillPath    = rhs.mOptimizeDrillPath;
   mEnableSolderPasteTop = rhs.mEnableSolderPasteTop;
   mEnableSolderPasteBot = rhs.mEnableSolderPasteBot;
   return *this;
@@ -202,6 +208,7 @@ bool BoardFabricationOutputSettings::operator==(
   if (mSilkscreenLayersTop != rhs.mSilkscreenLayersTop) return false;
   if (mSilkscreenLayersBot != rhs.mSilkscreenLayersBot) return false;
   if (mMergeDrillFiles != rhs.mMergeDrillFiles) return false;
+  if (mOptimizeDrillPath != rhs.mOptimizeDrillPath) return false;
   if (mEnableSolderPasteTop != rhs.mEnableSolderPasteTop) return false;
   if (mEnableSolderPasteBot != rhs.mEnableSolderPasteBot) return false;
   return true;
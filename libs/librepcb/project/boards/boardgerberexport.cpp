@@ -48,6 +48,7 @@
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -79,28 +80,84 @@ FilePath BoardGerberExport::getOutputDirectory() const noexcept {
  *  General Methods
  ******************************************************************************/
 
-void BoardGerberExport::exportAllLayers() const {
+void BoardGerberExport::exportAllLayers(bool parallel) const {
   mWrittenFiles.clear();
 
-  if (mBoard.getFabricationOutputSettings().getMergeDrillFiles()) {
-    exportDrills();
+  // Determine all files to export. The file paths need to be determined here
+  // since they depend on mCurrentInnerCopperLayer, which must not be modified
+  // while jobs are running in parallel.
+  const BoardFabricationOutputSettings& s =
+      mBoard.getFabricationOutputSettings();
+  QList<Job> jobs;
+  if (s.getMergeDrillFiles()) {
+    jobs.append(
+        createJob(s.getSuffixDrills(), &BoardGerberExport::exportDrills));
   } else {
-    exportDrillsNpth();
-    exportDrillsPth();
-  }
-  exportLayerBoardOutlines();
-  exportLayerTopCopper();
-  exportLayerInnerCopper();
-  exportLayerBottomCopper();
-  exportLayerTopSolderMask();
-  exportLayerBottomSolderMask();
-  exportLayerTopSilkscreen();
-  exportLayerBottomSilkscreen();
-  if (mBoard.getFabricationOutputSettings().getEnableSolderPasteTop()) {
-    exportLayerTopSolderPaste();
-  }
-  if (mBoard.getFabricationOutputSettings().getEnableSolderPasteBot()) {
-    exportLayerBottomSolderPaste();
+    jobs.append(createJob(s.getSuffixDrillsNpth(),
+                          &BoardGerberExport::exportDrillsNpth));
+    jobs.append(
+        createJob(s.getSuffixDrillsPth(), &BoardGerberExport::exportDrillsPth));
+  }
+  jobs.append(createJob(s.getSuffixOutlines(), GraphicsLayer::sBoardOutlines));
+  jobs.append(createJob(s.getSuffixCopperTop(), GraphicsLayer::sTopCopper));
+  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
+    mCurrentInnerCopperLayer = i;  // used for attribute provider
+    jobs.append(createJob(s.getSuffixCopperInner(),
+                          GraphicsLayer::getInnerLayerName(i)));
+  }
+  mCurrentInnerCopperLayer = 0;
+  jobs.append(createJob(s.getSuffixCopperBot(), GraphicsLayer::sBotCopper));
+  jobs.append(
+      createJob(s.getSuffixSolderMaskTop(), GraphicsLayer::sTopStopMask));
+  jobs.append(
+      createJob(s.getSuffixSolderMaskBot(), GraphicsLayer::sBotStopMask));
+  if (s.getSilkscreenLayersTop().count() > 0) {
+    // don't create silkscreen file if no layers selected
+    jobs.append(createJob(s.getSuffixSilkscreenTop(),
+                          &BoardGerberExport::exportLayerTopSilkscreen));
+  }
+  if (s.getSilkscreenLayersBot().count() > 0) {
+    // don't create silkscreen file if no layers selected
+    jobs.append(createJob(s.getSuffixSilkscreenBot(),
+                          &BoardGerberExport::exportLayerBottomSilkscreen));
+  }
+  if (s.getEnableSolderPasteTop()) {
+    jobs.append(
+        createJob(s.getSuffixSolderPasteTop(), GraphicsLayer::sTopSolderPaste));
+  }
+  if (s.getEnableSolderPasteBot()) {
+    jobs.append(
+        createJob(s.getSuffixSolderPasteBot(), GraphicsLayer::sBotSolderPaste));
+  }
+
+  // Run all jobs. The board is only read by the jobs, so they can safely run
+  // in parallel. In case of errors, all jobs are finished before the first
+  // error is rethrown.
+  QVector<bool> written(jobs.count(), false);
+  if (parallel) {
+    QList<QFuture<bool>> futures;
+    foreach (const Job& job, jobs) {
+      futures.append(
+          QtConcurrent::run([job]() { return job.function(job.filepath); }));
+    }
+    QScopedPointer<Exception> error;
+    for (int i = 0; i < futures.count(); ++i) {
+      try {
+        written[i] = futures[i].result();  // can throw
+      } catch (const Exception& e) {
+        if (!error) error.reset(e.clone());
+      } catch (...) {
+        if (!error) error.reset(new RuntimeError(__FILE__, __LINE__));
+      }
+    }
+    if (error) error->raise();
+  } else {
+    for (int i = 0; i < jobs.count(); ++i) {
+      written[i] = jobs[i].function(jobs[i].filepath);  // can throw
+    }
+  }
+  for (int i = 0; i < jobs.count(); ++i) {
+    if (written[i]) mWrittenFiles.append(jobs[i].filepath);
   }
 }
 
@@ -126,22 +183,42 @@ BoardGerberExport::getAttributeProviderParents() const noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void BoardGerberExport::exportDrills() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrills());
+BoardGerberExport::Job BoardGerberExport::createJob(
+    const QString& suffix, ExportFunction function) const noexcept {
+  Job job;
+  job.filepath = getOutputFilePath(suffix);
+  job.function = [this, function](const FilePath& fp) {
+    return (this->*function)(fp);
+  };
+  return job;
+}
+
+BoardGerberExport::Job BoardGerberExport::createJob(
+    const QString& suffix, const QString& layerName) const noexcept {
+  Job job;
+  job.filepath = getOutputFilePath(suffix);
+  job.function = [this, layerName](const FilePath& fp) {
+    return exportLayer(fp, layerName);
+  };
+  return job;
+}
+
+bool BoardGerberExport::exportDrills(const FilePath& fp) const {
   ExcellonGenerator gen;
+  gen.setOptimizeDrillPath(
+      mBoard.getFabricationOutputSettings().getOptimizeDrillPath());
   drawPthDrills(gen);
   drawNpthDrills(gen);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportDrillsNpth() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrillsNpth());
+bool BoardGerberExport::exportDrillsNpth(const FilePath& fp) const {
   ExcellonGenerator gen;
-  int               count = drawNpthDrills(gen);
+  gen.setOptimizeDrillPath(
+      mBoard.getFabricationOutputSettings().getOptimizeDrillPath());
+  int count = drawNpthDrills(gen);
   if (count > 0) {
     // Some PCB manufacturers don't like to have separate drill files for PTH
     // and NPTH. As many boards don't have non-plated holes anyway, we create
@@ -149,156 +226,58 @@ void BoardGerberExport::exportDrillsNpth() const {
     // issues with manufacturers...
     gen.generate();
     gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    return true;
+  } else {
+    return false;
   }
 }
 
-void BoardGerberExport::exportDrillsPth() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrillsPth());
+bool BoardGerberExport::exportDrillsPth(const FilePath& fp) const {
   ExcellonGenerator gen;
+  gen.setOptimizeDrillPath(
+      mBoard.getFabricationOutputSettings().getOptimizeDrillPath());
   drawPthDrills(gen);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBoardOutlines() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixOutlines());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBoardOutlines);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerTopCopper() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixCopperTop());
+bool BoardGerberExport::exportLayer(const FilePath& fp,
+                                    const QString&  layerName) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  drawLayer(gen, layerName);
+  gen.saveToFile(fp);  // can throw
+  return true;
 }
 
-void BoardGerberExport::exportLayerBottomCopper() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixCopperBot());
+bool BoardGerberExport::exportLayerTopSilkscreen(const FilePath& fp) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerInnerCopper() const {
-  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
-    mCurrentInnerCopperLayer = i;  // used for attribute provider
-    FilePath fp              = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixCopperInner());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::getInnerLayerName(i));
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+  foreach (const QString& layer,
+           mBoard.getFabricationOutputSettings().getSilkscreenLayersTop()) {
+    drawLayer(gen, layer);
   }
-  mCurrentInnerCopperLayer = 0;
-}
-
-void BoardGerberExport::exportLayerTopSolderMask() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderMaskTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
+  gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
   drawLayer(gen, GraphicsLayer::sTopStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.saveToFile(fp);  // can throw
+  return true;
 }
 
-void BoardGerberExport::exportLayerBottomSolderMask() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderMaskBot());
+bool BoardGerberExport::exportLayerBottomSilkscreen(const FilePath& fp) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerTopSilkscreen() const {
-  QStringList layers =
-      mBoard.getFabricationOutputSettings().getSilkscreenLayersTop();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixSilkscreenTop());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
-}
-
-void BoardGerberExport::exportLayerBottomSilkscreen() const {
-  QStringList layers =
-      mBoard.getFabricationOutputSettings().getSilkscreenLayersBot();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixSilkscreenBot());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+  foreach (const QString& layer,
+           mBoard.getFabricationOutputSettings().getSilkscreenLayersBot()) {
+    drawLayer(gen, layer);
   }
-}
-
-void BoardGerberExport::exportLayerTopSolderPaste() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderPasteTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBottomSolderPaste() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderPasteBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
+  drawLayer(gen, GraphicsLayer::sBotStopMask);
+  gen.saveToFile(fp);  // can throw
+  return true;
 }
 
 int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
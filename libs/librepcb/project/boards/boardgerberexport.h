@@ -29,6 +29,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -74,7 +76,15 @@ public:
   }
 
   // General Methods
-  void exportAllLayers() const;
+
+  /**
+   * @brief Export all Gerber and Excellon files of the board
+   *
+   * @param parallel  If true, all files are generated concurrently in the
+   *                  global thread pool. The board must not be modified
+   *                  until this method returns.
+   */
+  void exportAllLayers(bool parallel = false) const;
 
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getBuiltInAttributeValue()
@@ -90,20 +100,23 @@ signals:
   void attributesChanged() override;
 
 private:
+  // Types
+  typedef bool (BoardGerberExport::*ExportFunction)(const FilePath&) const;
+  struct Job {
+    FilePath                             filepath;
+    std::function<bool(const FilePath&)> function;  ///< Returns if written
+  };
+
   // Private Methods
-  void exportDrills() const;
-  void exportDrillsNpth() const;
-  void exportDrillsPth() const;
-  void exportLayerBoardOutlines() const;
-  void exportLayerTopCopper() const;
-  void exportLayerInnerCopper() const;
-  void exportLayerBottomCopper() const;
-  void exportLayerTopSolderMask() const;
-  void exportLayerBottomSolderMask() const;
-  void exportLayerTopSilkscreen() const;
-  void exportLayerBottomSilkscreen() const;
-  void exportLayerTopSolderPaste() const;
-  void exportLayerBottomSolderPaste() const;
+  Job  createJob(const QString& suffix, ExportFunction function) const noexcept;
+  Job  createJob(const QString& suffix,
+                 const QString& layerName) const noexcept;
+  bool exportDrills(const FilePath& fp) const;
+  bool exportDrillsNpth(const FilePath& fp) const;
+  bool exportDrillsPth(const FilePath& fp) const;
+  bool exportLayer(const FilePath& fp, const QString& layerName) const;
+  bool exportLayerTopSilkscreen(const FilePath& fp) const;
+  bool exportLayerBottomSilkscreen(const FilePath& fp) const;
 
   int  drawNpthDrills(ExcellonGenerator& gen) const;
   int  drawPthDrills(ExcellonGenerator& gen) const;
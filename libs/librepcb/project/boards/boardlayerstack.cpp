@@ -137,6 +137,38 @@ void BoardLayerStack::serialize(SExpression& root) const {
   root.appendChild("inner", mInnerLayerCount, false);
 }
 
+/*******************************************************************************
+ *  Inherited from IF_GraphicsLayerObserver
+ ******************************************************************************/
+
+void BoardLayerStack::layerColorChanged(const GraphicsLayer& layer,
+                                        const QColor& newColor) noexcept {
+  Q_UNUSED(layer);
+  Q_UNUSED(newColor);
+}
+
+void BoardLayerStack::layerHighlightColorChanged(
+    const GraphicsLayer& layer, const QColor& newColor) noexcept {
+  Q_UNUSED(layer);
+  Q_UNUSED(newColor);
+}
+
+void BoardLayerStack::layerVisibleChanged(const GraphicsLayer& layer,
+                                          bool newVisible) noexcept {
+  Q_UNUSED(newVisible);
+  emit layerVisibilityChanged(layer);
+}
+
+void BoardLayerStack::layerEnabledChanged(const GraphicsLayer& layer,
+                                          bool newEnabled) noexcept {
+  Q_UNUSED(layer);
+  Q_UNUSED(newEnabled);
+}
+
+void BoardLayerStack::layerDestroyed(const GraphicsLayer& layer) noexcept {
+  layer.unregisterObserver(*this);
+}
+
 /*******************************************************************************
  *  Private Slots
  ******************************************************************************/
@@ -220,6 +252,7 @@ void BoardLayerStack::addLayer(const QString& name, bool disable) noexcept {
 }
 
 void BoardLayerStack::addLayer(GraphicsLayer* layer) noexcept {
+  layer->registerObserver(*this);
   connect(layer, &GraphicsLayer::attributesChanged, this,
           &BoardLayerStack::layerAttributesChanged, Qt::QueuedConnection);
   mLayers.append(layer);
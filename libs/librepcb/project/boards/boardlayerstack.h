@@ -47,7 +47,8 @@ class Board;
  */
 class BoardLayerStack final : public QObject,
                               public SerializableObject,
-                              public IF_GraphicsLayerProvider {
+                              public IF_GraphicsLayerProvider,
+                              public IF_GraphicsLayerObserver {
   Q_OBJECT
 
 public:
@@ -87,9 +88,30 @@ public:
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
 
+  // Inherited from IF_GraphicsLayerObserver
+  void layerColorChanged(const GraphicsLayer& layer,
+                         const QColor&        newColor) noexcept override;
+  void layerHighlightColorChanged(const GraphicsLayer& layer,
+                                  const QColor& newColor) noexcept override;
+  void layerVisibleChanged(const GraphicsLayer& layer,
+                           bool                 newVisible) noexcept override;
+  void layerEnabledChanged(const GraphicsLayer& layer,
+                           bool                 newEnabled) noexcept override;
+  void layerDestroyed(const GraphicsLayer& layer) noexcept override;
+
   // Operator Overloadings
   BoardLayerStack& operator=(const BoardLayerStack& rhs) = delete;
 
+signals:
+  /**
+   * @brief Emitted immediately when a layer was shown or hidden
+   *
+   * In contrast to Board::attributesChanged(), this signal is not delayed,
+   * so items whose grab area depends on the layer visibility can update
+   * their entry in the board's spatial index before the next hit-test.
+   */
+  void layerVisibilityChanged(const GraphicsLayer& layer);
+
 private slots:
   void layerAttributesChanged() noexcept;
   void boardAttributesChanged() noexcept;
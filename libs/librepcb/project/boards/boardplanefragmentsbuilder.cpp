@@ -51,7 +51,7 @@ namespace project {
  ******************************************************************************/
 
 BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept
-  : mPlane(plane) {
+  : mPlane(plane), mLastInputValid(false) {
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
@@ -62,17 +62,44 @@ BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
  ******************************************************************************/
 
 QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
+  if (prepareInput()) {
+    return buildFromInput();
+  } else {
+    return QVector<Path>();
+  }
+}
+
+bool BoardPlaneFragmentsBuilder::prepareInput() noexcept {
+  try {
+    collectInput();  // can throw
+    return true;
+  } catch (const Exception& e) {
+    qCritical() << "Failed to build plane fragments! Leave plane empty...";
+    qCritical() << "Inner error message:" << e.getMsg();
+    mLastInputValid = false;
+    return false;
+  }
+}
+
+QVector<Path> BoardPlaneFragmentsBuilder::buildFromInput() noexcept {
   try {
+    if (mLastInputValid && (mInput == mLastInput)) {
+      return mLastFragments;  // nothing relevant has changed
+    }
+    mLastInputValid = false;
     mResult.clear();
     addPlaneOutline();
     clipToBoardOutline();
     subtractOtherObjects();
     ensureMinimumWidth();
     flattenResult();
-    if (!mPlane.getKeepOrphans()) {
+    if (!mInput.keepOrphans) {
       removeOrphans();
     }
-    return ClipperHelpers::convert(mResult);
+    mLastFragments  = ClipperHelpers::convert(mResult);
+    mLastInput      = mInput;
+    mLastInputValid = true;
+    return mLastFragments;
   } catch (const Exception& e) {
     qCritical() << "Failed to build plane fragments! Leave plane empty...";
     qCritical() << "Inner error message:" << e.getMsg();
@@ -84,122 +111,136 @@ QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void BoardPlaneFragmentsBuilder::addPlaneOutline() {
-  mResult.push_back(
-      ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance()));
-}
+void BoardPlaneFragmentsBuilder::collectInput() {
+  mInput = Input();
+  mUsedPathCache.clear();
+  mUsedPlaneCache.clear();
 
-void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
-  // determine board area
-  ClipperLib::Paths   boardArea;
-  ClipperLib::Clipper boardAreaClipper;
+  // plane outline and settings
+  mInput.outline =
+      ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance());
+  mOutlineBounds           = getBounds(mInput.outline);
+  mInput.minClearance      = mPlane.getMinClearance();
+  mInput.minWidth          = mPlane.getMinWidth();
+  mInput.keepOrphans       = mPlane.getKeepOrphans();
+
+  UnsignedLength   clearance = mPlane.getMinClearance();
+  const NetSignal* netsignal = &mPlane.getNetSignal();
+  bool connect = (mPlane.getConnectStyle() != BI_Plane::ConnectStyle::None);
+
+  // board outlines
   foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
     if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
-      ClipperLib::Path path = ClipperHelpers::convert(
-          polygon->getPolygon().getPath(), maxArcTolerance());
-      boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
+      mInput.boardOutlines.push_back(
+          convertCached(polygon->getPolygon().getPath()).path);
     }
   }
-  boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
-                           ClipperLib::pftEvenOdd);
 
-  // perform clearance offset
-  ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(),
-                         maxArcTolerance());  // can throw
-
-  // if we have no board area, abort here
-  if (boardArea.empty()) return;
-
-  // clip result to board area
-  ClipperLib::Clipper clip;
-  clip.AddPaths(mResult, ClipperLib::ptSubject, true);
-  clip.AddPaths(boardArea, ClipperLib::ptClip, true);
-  clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
-               ClipperLib::pftNonZero);
-}
-
-void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
-  ClipperLib::Clipper c;
-  c.AddPaths(mResult, ClipperLib::ptSubject, true);
-
-  // subtract other planes
+  // other planes
   foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
     if (plane == &mPlane) continue;
     if (*plane < mPlane) continue;  // ignore planes with lower priority
     if (plane->getLayerName() != mPlane.getLayerName()) continue;
-    if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
-    ClipperLib::Paths paths =
-        ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
-    ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
-                           maxArcTolerance());  // can throw
-    c.AddPaths(paths, ClipperLib::ptClip, true);
+    if (&plane->getNetSignal() == netsignal) continue;
+    addOtherPlaneCutOut(*plane);  // can throw
   }
 
-  // subtract holes and pads from devices
+  // holes and pads from devices
   foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
     for (const Hole& hole :
          device->getFootprint().getLibFootprint().getHoles()) {
       Point pos = device->getFootprint().mapToScene(hole.getPosition());
-      PositiveLength dia(hole.getDiameter() + mPlane.getMinClearance() * 2);
-      Path           path = Path::circle(dia).translated(pos);
-      c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-                ClipperLib::ptClip, true);
+      PositiveLength dia(hole.getDiameter() + clearance * 2);
+      addCutOut(Path::circle(dia).translated(pos));
     }
     foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
       if (!pad->isOnLayer(*mPlane.getLayerName())) continue;
-      if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(pad->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+      bool sameNetSignal = (pad->getCompSigInstNetSignal() == netsignal);
+      if (sameNetSignal) {
+        addConnectedNetSignalArea(pad->getSceneOutline());
+      }
+      if ((!sameNetSignal) || (!connect)) {
+        addCutOut(pad->getSceneOutline(*clearance));
       }
-      c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
     }
   }
 
-  // subtract board holes
+  // board holes
   for (const BI_Hole* hole : mPlane.getBoard().getHoles()) {
-    PositiveLength dia(hole->getHole().getDiameter() +
-                       mPlane.getMinClearance() * 2);
-    Path path = Path::circle(dia).translated(hole->getHole().getPosition());
-    c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-              ClipperLib::ptClip, true);
+    PositiveLength dia(hole->getHole().getDiameter() + clearance * 2);
+    addCutOut(Path::circle(dia).translated(hole->getHole().getPosition()));
   }
 
-  // subtract net segment items
+  // net segment items
   foreach (const BI_NetSegment* netsegment,
            mPlane.getBoard().getNetSegments()) {
-    // subtract vias
+    bool sameNetSignal = (&netsegment->getNetSignal() == netsignal);
+
+    // vias
     foreach (const BI_Via* via, netsegment->getVias()) {
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(via->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+      if (sameNetSignal) {
+        addConnectedNetSignalArea(via->getSceneOutline());
+      }
+      if ((!sameNetSignal) || (!connect)) {
+        addCutOut(via->getSceneOutline(*clearance));
       }
-      c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
     }
 
-    // subtract netlines
+    // netlines
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       if (netline->getLayer().getName() != mPlane.getLayerName()) continue;
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+      if (sameNetSignal) {
+        addConnectedNetSignalArea(netline->getSceneOutline());
       } else {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(*mPlane.getMinClearance()),
-            maxArcTolerance());
-        c.AddPath(path, ClipperLib::ptClip, true);
+        addCutOut(netline->getSceneOutline(*clearance));
       }
     }
   }
 
+  // drop cache entries of objects which no longer exist or have changed
+  mPathCache.swap(mUsedPathCache);
+  mPlaneCache.swap(mUsedPlaneCache);
+  mUsedPathCache.clear();
+  mUsedPlaneCache.clear();
+}
+
+void BoardPlaneFragmentsBuilder::addPlaneOutline() {
+  mResult.push_back(mInput.outline);
+}
+
+void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
+  // determine board area
+  ClipperLib::Paths   boardArea;
+  ClipperLib::Clipper boardAreaClipper;
+  boardAreaClipper.AddPaths(mInput.boardOutlines, ClipperLib::ptSubject, true);
+  boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
+                           ClipperLib::pftEvenOdd);
+
+  // perform clearance offset
+  ClipperHelpers::offset(boardArea, -mInput.minClearance,
+                         maxArcTolerance());  // can throw
+
+  // if we have no board area, abort here
+  if (boardArea.empty()) return;
+
+  // clip result to board area
+  ClipperLib::Clipper clip;
+  clip.AddPaths(mResult, ClipperLib::ptSubject, true);
+  clip.AddPaths(boardArea, ClipperLib::ptClip, true);
+  clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
+               ClipperLib::pftNonZero);
+}
+
+void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
+  ClipperLib::Clipper c;
+  c.AddPaths(mResult, ClipperLib::ptSubject, true);
+  c.AddPaths(mInput.cutOuts, ClipperLib::ptClip, true);
   c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
             ClipperLib::pftNonZero);
 }
 
 void BoardPlaneFragmentsBuilder::ensureMinimumWidth() {
-  Length delta = mPlane.getMinWidth() / 2;
+  Length delta = mInput.minWidth / 2;
   ClipperHelpers::offset(mResult, -delta, maxArcTolerance());  // can throw
   ClipperHelpers::offset(mResult, delta, maxArcTolerance());   // can throw
 }
@@ -222,7 +263,7 @@ void BoardPlaneFragmentsBuilder::removeOrphans() {
                     [this](const ClipperLib::Path& p) {
                       ClipperLib::Paths   intersections;
                       ClipperLib::Clipper c;
-                      c.AddPaths(mConnectedNetSignalAreas,
+                      c.AddPaths(mInput.connectedNetSignalAreas,
                                  ClipperLib::ptSubject, true);
                       c.AddPath(p, ClipperLib::ptClip, true);
                       c.Execute(ClipperLib::ctIntersection, intersections,
@@ -236,30 +277,89 @@ void BoardPlaneFragmentsBuilder::removeOrphans() {
  *  Helper Methods
  ******************************************************************************/
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(
-    const BI_FootprintPad& pad) const noexcept {
-  bool differentNetSignal =
-      (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        pad.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
+void BoardPlaneFragmentsBuilder::addCutOut(const Path& path) noexcept {
+  const CachedPath& cached = convertCached(path);
+  if (overlaps(cached.bounds, mOutlineBounds)) {
+    mInput.cutOuts.push_back(cached.path);
   }
 }
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(
-    const BI_Via& via) const noexcept {
-  bool differentNetSignal =
-      (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        via.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
+void BoardPlaneFragmentsBuilder::addConnectedNetSignalArea(
+    const Path& path) noexcept {
+  const CachedPath& cached = convertCached(path);
+  if (overlaps(cached.bounds, mOutlineBounds)) {
+    mInput.connectedNetSignalAreas.push_back(cached.path);
+  }
+}
+
+void BoardPlaneFragmentsBuilder::addOtherPlaneCutOut(const BI_Plane& plane) {
+  auto it = mPlaneCache.find(&plane);
+  if ((it == mPlaneCache.end()) ||
+      (it->fragments != plane.getFragments()) ||
+      (it->clearance != *mPlane.getMinClearance())) {
+    CachedPlaneCutOut cutOut;
+    cutOut.fragments = plane.getFragments();
+    cutOut.clearance = *mPlane.getMinClearance();
+    cutOut.paths =
+        ClipperHelpers::convert(plane.getFragments(), maxArcTolerance());
+    ClipperHelpers::offset(cutOut.paths, *mPlane.getMinClearance(),
+                           maxArcTolerance());  // can throw
+    it = mPlaneCache.insert(&plane, cutOut);
   }
+  mUsedPlaneCache.insert(&plane, *it);
+  for (const ClipperLib::Path& path : it->paths) {
+    if (overlaps(getBounds(path), mOutlineBounds)) {
+      mInput.cutOuts.push_back(path);
+    }
+  }
+}
+
+const BoardPlaneFragmentsBuilder::CachedPath&
+    BoardPlaneFragmentsBuilder::convertCached(const Path& path) noexcept {
+  auto it = mUsedPathCache.find(path);
+  if (it == mUsedPathCache.end()) {
+    auto cached = mPathCache.constFind(path);
+    if (cached != mPathCache.constEnd()) {
+      it = mUsedPathCache.insert(path, *cached);
+    } else {
+      CachedPath item;
+      item.path   = ClipperHelpers::convert(path, maxArcTolerance());
+      item.bounds = getBounds(item.path);
+      it          = mUsedPathCache.insert(path, item);
+    }
+  }
+  return *it;
+}
+
+ClipperLib::IntRect BoardPlaneFragmentsBuilder::getBounds(
+    const ClipperLib::Path& path) noexcept {
+  ClipperLib::IntRect rect = {0, 0, 0, 0};
+  if (!path.empty()) {
+    rect = {path.front().X, path.front().Y, path.front().X, path.front().Y};
+    for (const ClipperLib::IntPoint& p : path) {
+      rect.left   = std::min(rect.left, p.X);
+      rect.top    = std::min(rect.top, p.Y);
+      rect.right  = std::max(rect.right, p.X);
+      rect.bottom = std::max(rect.bottom, p.Y);
+    }
+  }
+  return rect;
+}
+
+bool BoardPlaneFragmentsBuilder::overlaps(
+    const ClipperLib::IntRect& a, const ClipperLib::IntRect& b) noexcept {
+  // touching rects are considered as overlapping to be on the safe side
+  return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+         (b.top <= a.bottom);
+}
+
+bool BoardPlaneFragmentsBuilder::Input::operator==(const Input& rhs) const
+    noexcept {
+  return (outline == rhs.outline) && (boardOutlines == rhs.boardOutlines) &&
+         (cutOuts == rhs.cutOuts) &&
+         (connectedNetSignalAreas == rhs.connectedNetSignalAreas) &&
+         (minClearance == rhs.minClearance) && (minWidth == rhs.minWidth) &&
+         (keepOrphans == rhs.keepOrphans);
 }
 
 /*******************************************************************************
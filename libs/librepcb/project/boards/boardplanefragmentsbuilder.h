@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include <clipper/clipper.hpp>
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/all_length_units.h>
 
 #include <QtCore>
 
@@ -44,6 +45,16 @@ class BI_FootprintPad;
 
 /**
  * @brief The BoardPlaneFragmentsBuilder class
+ *
+ * The builder is intended to be kept alive together with its plane to make
+ * subsequent rebuilds cheap:
+ *
+ *   - Objects whose bounding box does not touch the plane outline are ignored,
+ *     they can't affect the fragments at all.
+ *   - The flattened (clearance-offset) cut-outs of all objects are cached and
+ *     reused as long as the objects did not change.
+ *   - If none of the relevant objects changed since the last build, the
+ *     previously built fragments are returned without any clipping.
  */
 class BoardPlaneFragmentsBuilder final {
 public:
@@ -54,13 +65,68 @@ public:
   ~BoardPlaneFragmentsBuilder() noexcept;
 
   // General Methods
+
+  /**
+   * @brief Build the plane fragments (#prepareInput() + #buildFromInput())
+   *
+   * @return The new fragments (empty on failure)
+   */
   QVector<Path> buildFragments() noexcept;
 
+  /**
+   * @brief Collect all board objects which affect the plane
+   *
+   * Must be called from the main thread since it accesses the board.
+   *
+   * @retval true   On success.
+   * @retval false  On failure (the plane should be left empty).
+   */
+  bool prepareInput() noexcept;
+
+  /**
+   * @brief Build the plane fragments from the input of #prepareInput()
+   *
+   * Does not access the board, so it is allowed to call this method from
+   * any thread (but never concurrently for the same builder).
+   *
+   * @return The new fragments (empty on failure)
+   */
+  QVector<Path> buildFromInput() noexcept;
+
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
 
+private:  // Types
+  /**
+   * All the data the resulting fragments depend on
+   */
+  struct Input {
+    ClipperLib::Path  outline;
+    ClipperLib::Paths boardOutlines;
+    ClipperLib::Paths cutOuts;
+    ClipperLib::Paths connectedNetSignalAreas;
+    UnsignedLength    minClearance;
+    UnsignedLength    minWidth;
+    bool              keepOrphans;
+
+    Input() noexcept : minClearance(0), minWidth(0), keepOrphans(false) {}
+    bool operator==(const Input& rhs) const noexcept;
+  };
+
+  struct CachedPath {
+    ClipperLib::Path    path;
+    ClipperLib::IntRect bounds;
+  };
+
+  struct CachedPlaneCutOut {
+    QVector<Path>     fragments;
+    Length            clearance;
+    ClipperLib::Paths paths;
+  };
+
 private:  // Methods
+  void collectInput();
   void addPlaneOutline();
   void clipToBoardOutline();
   void subtractOtherObjects();
@@ -69,8 +135,13 @@ private:  // Methods
   void removeOrphans();
 
   // Helper Methods
-  ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-  ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
+  void addCutOut(const Path& path) noexcept;
+  void addConnectedNetSignalArea(const Path& path) noexcept;
+  void addOtherPlaneCutOut(const BI_Plane& plane);
+  const CachedPath& convertCached(const Path& path) noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Path& path) noexcept;
+  static bool overlaps(const ClipperLib::IntRect& a,
+                       const ClipperLib::IntRect& b) noexcept;
 
   /**
    * Returns the maximum allowed arc tolerance when flattening arcs. Do not
@@ -82,9 +153,21 @@ private:  // Methods
   }
 
 private:  // Data
-  BI_Plane&         mPlane;
-  ClipperLib::Paths mConnectedNetSignalAreas;
-  ClipperLib::Paths mResult;
+  BI_Plane&           mPlane;
+  Input               mInput;
+  ClipperLib::IntRect mOutlineBounds;
+  ClipperLib::Paths   mResult;
+
+  // Results of the last successful build
+  bool          mLastInputValid;
+  Input         mLastInput;
+  QVector<Path> mLastFragments;
+
+  // Caches, entries not used by the last build are dropped
+  QHash<Path, CachedPath>                   mPathCache;
+  QHash<Path, CachedPath>                   mUsedPathCache;
+  QHash<const BI_Plane*, CachedPlaneCutOut> mPlaneCache;
+  QHash<const BI_Plane*, CachedPlaneCutOut> mUsedPlaneCache;
 };
 
 /*******************************************************************************
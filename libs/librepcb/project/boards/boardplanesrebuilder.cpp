@@ -0,0 +1,154 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanesrebuilder.h"
+
+#include "board.h"
+#include "boardplanefragmentsbuilder.h"
+#include "items/bi_plane.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlanesRebuilder::BoardPlanesRebuilder(Board& board) noexcept
+  : mBoard(board) {
+}
+
+BoardPlanesRebuilder::~BoardPlanesRebuilder() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardPlanesRebuilder::rebuildAllPlanes() noexcept {
+  QList<BI_Plane*> planes = mBoard.getPlanes();
+  qSort(planes.begin(), planes.end(),
+        [](const BI_Plane* p1, const BI_Plane* p2) {
+          return !(*p1 < *p2);
+        });  // sort by priority (highest priority first)
+
+  // determine dependencies (only planes with higher priority are relevant)
+  QHash<const BI_Plane*, QRectF> areas;
+  foreach (const BI_Plane* plane, planes) {
+    areas.insert(plane, getAffectedArea(*plane));
+  }
+  QHash<const BI_Plane*, QList<const BI_Plane*>> dependencies;
+  for (int i = 0; i < planes.count(); ++i) {
+    for (int k = 0; k < i; ++k) {
+      if (dependsOn(*planes.at(i), areas.value(planes.at(i)), *planes.at(k),
+                    areas.value(planes.at(k)))) {
+        dependencies[planes.at(i)].append(planes.at(k));
+      }
+    }
+  }
+
+  // Rebuild planes. Since dependencies always have a higher priority, the
+  // first pending plane is always ready as soon as no jobs are running.
+  QList<BI_Plane*>                                pending = planes;
+  QSet<const BI_Plane*>                           finished;
+  QList<QPair<BI_Plane*, QFuture<QVector<Path>>>> running;
+  while ((!pending.isEmpty()) || (!running.isEmpty())) {
+    // start jobs for all planes whose dependencies are built
+    for (auto it = pending.begin(); it != pending.end();) {
+      bool ready = true;
+      foreach (const BI_Plane* dependency, dependencies.value(*it)) {
+        if (!finished.contains(dependency)) {
+          ready = false;
+          break;
+        }
+      }
+      if (!ready) {
+        ++it;
+        continue;
+      }
+      BI_Plane*                   plane   = *it;
+      BoardPlaneFragmentsBuilder* builder = &plane->getFragmentsBuilder();
+      if (builder->prepareInput()) {
+        running.append(qMakePair(plane, QtConcurrent::run([builder]() {
+                                   return builder->buildFromInput();
+                                 })));
+      } else {
+        plane->setFragments(QVector<Path>());
+        finished.insert(plane);
+      }
+      it = pending.erase(it);
+    }
+
+    // wait for the job with the highest priority, then apply all results
+    if (!running.isEmpty()) {
+      running.first().second.waitForFinished();
+      for (auto it = running.begin(); it != running.end();) {
+        if (it->second.isFinished()) {
+          it->first->setFragments(it->second.result());
+          finished.insert(it->first);
+          it = running.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool BoardPlanesRebuilder::dependsOn(const BI_Plane& plane,
+                                     const QRectF&   planeArea,
+                                     const BI_Plane& other,
+                                     const QRectF&   otherArea) noexcept {
+  if (other.getLayerName() != plane.getLayerName()) return false;
+  if (&other.getNetSignal() == &plane.getNetSignal()) return false;
+  // add some tolerance since touching rects are not considered as intersecting
+  qreal margin = plane.getMinClearance()->toPx() + 1;
+  return planeArea.adjusted(-margin, -margin, margin, margin)
+      .intersects(otherArea);
+}
+
+QRectF BoardPlanesRebuilder::getAffectedArea(const BI_Plane& plane) noexcept {
+  // The old fragments need to be taken into account too since they are still
+  // used by other planes until this plane is rebuilt.
+  QRectF area = plane.getOutline().toQPainterPathPx().boundingRect();
+  foreach (const Path& fragment, plane.getFragments()) {
+    area = area.united(fragment.toQPainterPathPx().boundingRect());
+  }
+  return area;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,85 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+#define LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Plane;
+
+/*******************************************************************************
+ *  Class BoardPlanesRebuilder
+ ******************************************************************************/
+
+/**
+ * @brief Rebuilds all planes of a board in parallel
+ *
+ * A plane only depends on planes with higher priority on the same layer,
+ * connected to another net signal and whose area (considering the clearance)
+ * overlaps with its own area. From these dependencies a DAG is built, and
+ * every plane whose dependencies are all built is scheduled on the global
+ * thread pool. Collecting the board objects of a plane as well as applying
+ * the resulting fragments to the plane (and its graphics item) is done in the
+ * calling (main) thread, only the clipping runs in worker threads. The result
+ * is exactly the same as when rebuilding the planes sequentially in priority
+ * order.
+ */
+class BoardPlanesRebuilder final {
+public:
+  // Constructors / Destructor
+  BoardPlanesRebuilder()                                  = delete;
+  BoardPlanesRebuilder(const BoardPlanesRebuilder& other) = delete;
+  explicit BoardPlanesRebuilder(Board& board) noexcept;
+  ~BoardPlanesRebuilder() noexcept;
+
+  // General Methods
+  void rebuildAllPlanes() noexcept;
+
+  // Operator Overloadings
+  BoardPlanesRebuilder& operator=(const BoardPlanesRebuilder& rhs) = delete;
+
+private:  // Methods
+  static bool   dependsOn(const BI_Plane& plane, const QRectF& planeArea,
+                          const BI_Plane& other,
+                          const QRectF&   otherArea) noexcept;
+  static QRectF getAffectedArea(const BI_Plane& plane) noexcept;
+
+private:  // Data
+  Board& mBoard;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
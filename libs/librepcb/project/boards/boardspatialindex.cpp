@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardspatialindex.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardSpatialIndex::BoardSpatialIndex() noexcept {
+}
+
+BoardSpatialIndex::~BoardSpatialIndex() noexcept {
+  Q_ASSERT(mTree.isEmpty());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool BoardSpatialIndex::isIndexed(BI_Base::Type_t type) noexcept {
+  switch (type) {
+    case BI_Base::Type_t::Footprint:
+    case BI_Base::Type_t::FootprintPad:
+    case BI_Base::Type_t::StrokeText:
+    case BI_Base::Type_t::Via:
+    case BI_Base::Type_t::NetPoint:
+    case BI_Base::Type_t::NetLine:
+      return true;
+    default:
+      return false;
+  }
+}
+
+QList<BI_Base*> BoardSpatialIndex::getItemsAt(const QPointF& posPx) const
+    noexcept {
+  updateInvalidatedItems();
+  return mTree.find(posPx);
+}
+
+QList<BI_Base*> BoardSpatialIndex::getItemsIn(const QRectF& rectPx) const
+    noexcept {
+  updateInvalidatedItems();
+  return mTree.find(rectPx);
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardSpatialIndex::addItem(BI_Base& item) noexcept {
+  if (isIndexed(item.getType())) {
+    // Note: The item is inserted with empty bounds and updated lazily since
+    // its graphics item might not be completely set up yet.
+    mTree.insert(&item, QRectF());
+    mInvalidatedItems.insert(&item);
+  }
+}
+
+void BoardSpatialIndex::removeItem(BI_Base& item) noexcept {
+  mTree.remove(&item);
+  mInvalidatedItems.remove(&item);
+}
+
+void BoardSpatialIndex::invalidateItem(BI_Base& item) noexcept {
+  if (mTree.contains(&item)) {
+    mInvalidatedItems.insert(&item);
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardSpatialIndex::updateInvalidatedItems() const noexcept {
+  foreach (BI_Base* item, mInvalidatedItems) {
+    mTree.insert(item, item->getGrabAreaScenePx().boundingRect());
+  }
+  mInvalidatedItems.clear();
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
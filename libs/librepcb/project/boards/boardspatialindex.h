@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDSPATIALINDEX_H
+#define LIBREPCB_PROJECT_BOARDSPATIALINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "items/bi_base.h"
+
+#include <librepcb/common/utils/rtree.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Class BoardSpatialIndex
+ ******************************************************************************/
+
+/**
+ * @brief Spatial index of the items in a board to speed up hit-testing
+ *
+ * Contains the grab area bounding rectangles of all footprints, footprint
+ * pads, stroke texts, vias, netpoints and netlines which are added to the
+ * board, organized in an R-tree. The index is maintained incrementally:
+ * Items register themselves when they are added to or removed from the board,
+ * and they invalidate their entry whenever their geometry has changed. The
+ * bounding rectangles of invalidated items are updated lazily on the next
+ * lookup, so moving many items (e.g. dragging a footprint) stays cheap.
+ *
+ * The index only returns candidates, callers still need to check the exact
+ * grab area (and other criteria like layer or visibility) of each item.
+ *
+ * @note The few planes, polygons and holes of a board are not indexed since
+ *       their geometry can be modified without notifying the board item.
+ */
+class BoardSpatialIndex final {
+public:
+  // Constructors / Destructor
+  BoardSpatialIndex() noexcept;
+  BoardSpatialIndex(const BoardSpatialIndex& other) = delete;
+  ~BoardSpatialIndex() noexcept;
+
+  // Getters
+  static bool     isIndexed(BI_Base::Type_t type) noexcept;
+  QList<BI_Base*> getItemsAt(const QPointF& posPx) const noexcept;
+  QList<BI_Base*> getItemsIn(const QRectF& rectPx) const noexcept;
+
+  // General Methods
+  void addItem(BI_Base& item) noexcept;
+  void removeItem(BI_Base& item) noexcept;
+  void invalidateItem(BI_Base& item) noexcept;
+
+  // Operator Overloadings
+  BoardSpatialIndex& operator=(const BoardSpatialIndex& rhs) = delete;
+
+private:  // Methods
+  void updateInvalidatedItems() const noexcept;
+
+private:  // Data
+  mutable RTree<BI_Base*> mTree;
+  mutable QSet<BI_Base*>  mInvalidatedItems;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDSPATIALINDEX_H
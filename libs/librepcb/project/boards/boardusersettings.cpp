@@ -86,12 +86,13 @@ BoardUserSettings::~BoardUserSettings() noexcept {
  *  General Methods
  ******************************************************************************/
 
-bool BoardUserSettings::save(bool toOriginal, QStringList& errors) noexcept {
+bool BoardUserSettings::save(bool toOriginal, QStringList& errors,
+                             AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   try {
     SExpression doc(serializeToDomElement("librepcb_board_user_settings"));
-    mFile->save(doc, toOriginal);
+    mFile->save(std::move(doc), toOriginal, writer);
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -33,6 +33,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class SmartSExprFile;
 class GraphicsLayerStackAppearanceSettings;
 
@@ -60,7 +61,8 @@ public:
   ~BoardUserSettings() noexcept;
 
   // General Methods
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
 
   // Operator Overloadings
   BoardUserSettings& operator=(const BoardUserSettings& rhs) = delete;
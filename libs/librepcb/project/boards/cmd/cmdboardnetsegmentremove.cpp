@@ -23,7 +23,10 @@
 #include "cmdboardnetsegmentremove.h"
 
 #include "../board.h"
+#include "../items/bi_netline.h"
+#include "../items/bi_netpoint.h"
 #include "../items/bi_netsegment.h"
+#include "../items/bi_via.h"
 
 #include <QtCore>
 
@@ -47,6 +50,20 @@ CmdBoardNetSegmentRemove::CmdBoardNetSegmentRemove(
 CmdBoardNetSegmentRemove::~CmdBoardNetSegmentRemove() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardNetSegmentRemove::getMemoryUsage() const noexcept {
+  // the removed net segment and all its elements are kept by this command
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdBoardNetSegmentRemove) - sizeof(UndoCommand)) +
+         sizeof(BI_NetSegment) +
+         (mNetSegment.getVias().count() * sizeof(BI_Via)) +
+         (mNetSegment.getNetPoints().count() * sizeof(BI_NetPoint)) +
+         (mNetSegment.getNetLines().count() * sizeof(BI_NetLine));
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
@@ -49,6 +49,11 @@ public:
   explicit CmdBoardNetSegmentRemove(BI_NetSegment& segment) noexcept;
   ~CmdBoardNetSegmentRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
@@ -51,6 +51,11 @@ public:
   CmdBoardNetSegmentRemoveElements(BI_NetSegment& segment) noexcept;
   ~CmdBoardNetSegmentRemoveElements() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // General Methods
   void removeVia(BI_Via& via);
   void removeNetPoint(BI_NetPoint& netpoint);
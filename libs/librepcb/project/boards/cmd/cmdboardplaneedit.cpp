@@ -68,6 +68,18 @@ CmdBoardPlaneEdit::~CmdBoardPlaneEdit() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPlaneEdit::getMemoryUsage() const noexcept {
+  int vertices = mOldOutline.getVertices().capacity() +
+                 mNewOutline.getVertices().capacity();
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdBoardPlaneEdit) - sizeof(UndoCommand)) +
+         (vertices * sizeof(Vertex));
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -51,6 +51,11 @@ public:
   CmdBoardPlaneEdit(BI_Plane& plane, bool rebuildOnChanges) noexcept;
   ~CmdBoardPlaneEdit() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // Setters
   void setDeltaToStartPos(const Point& deltaPos, bool immediate) noexcept;
   void rotate(const Angle& angle, const Point& center, bool immediate) noexcept;
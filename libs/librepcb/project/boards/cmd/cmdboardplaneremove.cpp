@@ -46,6 +46,20 @@ CmdBoardPlaneRemove::CmdBoardPlaneRemove(BI_Plane& plane) noexcept
 CmdBoardPlaneRemove::~CmdBoardPlaneRemove() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPlaneRemove::getMemoryUsage() const noexcept {
+  int vertices = mPlane.getOutline().getVertices().capacity();
+  foreach (const Path& fragment, mPlane.getFragments()) {
+    vertices += fragment.getVertices().capacity();
+  }
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdBoardPlaneRemove) - sizeof(UndoCommand)) +
+         sizeof(BI_Plane) + (vertices * sizeof(Vertex));
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
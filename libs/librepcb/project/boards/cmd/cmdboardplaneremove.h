@@ -49,6 +49,11 @@ public:
   explicit CmdBoardPlaneRemove(BI_Plane& plane) noexcept;
   ~CmdBoardPlaneRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
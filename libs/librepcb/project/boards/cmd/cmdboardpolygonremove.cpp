@@ -25,6 +25,8 @@
 #include "../board.h"
 #include "../items/bi_polygon.h"
 
+#include <librepcb/common/geometry/polygon.h>
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -46,6 +48,17 @@ CmdBoardPolygonRemove::CmdBoardPolygonRemove(BI_Polygon& polygon) noexcept
 CmdBoardPolygonRemove::~CmdBoardPolygonRemove() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPolygonRemove::getMemoryUsage() const noexcept {
+  int vertices = mPolygon.getPolygon().getPath().getVertices().capacity();
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdBoardPolygonRemove) - sizeof(UndoCommand)) +
+         sizeof(BI_Polygon) + sizeof(Polygon) + (vertices * sizeof(Vertex));
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
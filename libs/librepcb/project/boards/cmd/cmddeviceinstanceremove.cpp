@@ -24,6 +24,9 @@
 
 #include "../board.h"
 #include "../items/bi_device.h"
+#include "../items/bi_footprint.h"
+#include "../items/bi_footprintpad.h"
+#include "../items/bi_stroketext.h"
 
 #include <QtCore>
 
@@ -46,6 +49,20 @@ CmdDeviceInstanceRemove::CmdDeviceInstanceRemove(BI_Device& dev) noexcept
 CmdDeviceInstanceRemove::~CmdDeviceInstanceRemove() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdDeviceInstanceRemove::getMemoryUsage() const noexcept {
+  // the removed device and its footprint are kept by this command
+  const BI_Footprint& footprint = mDevice.getFootprint();
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdDeviceInstanceRemove) - sizeof(UndoCommand)) +
+         sizeof(BI_Device) + sizeof(BI_Footprint) +
+         (footprint.getPads().count() * sizeof(BI_FootprintPad)) +
+         (footprint.getStrokeTexts().count() * sizeof(BI_StrokeText));
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
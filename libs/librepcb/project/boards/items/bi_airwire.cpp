@@ -45,6 +45,18 @@ BI_AirWire::BI_AirWire(Board& board, const NetSignal& netsignal,
 BI_AirWire::~BI_AirWire() noexcept {
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BI_AirWire::setPoints(const Point& p1, const Point& p2) noexcept {
+  if ((p1 != mP1) || (p2 != mP2)) {
+    mP1 = p1;
+    mP2 = p2;
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -58,6 +58,9 @@ public:
   const Point&     getP2() const noexcept { return mP2; }
   bool             isVertical() const noexcept { return mP1 == mP2; }
 
+  // Setters
+  void setPoints(const Point& p1, const Point& p2) noexcept;
+
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
@@ -24,6 +24,7 @@
 
 #include "../../project.h"
 #include "../board.h"
+#include "../boardspatialindex.h"
 #include "../graphicsitems/bgi_base.h"
 
 #include <librepcb/common/graphics/graphicsscene.h>
@@ -77,6 +78,7 @@ void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
   if (item) {
     mBoard.getGraphicsScene().addItem(*item);
   }
+  mBoard.getSpatialIndex().addItem(*this);
   mIsAddedToBoard = true;
 }
 
@@ -85,9 +87,17 @@ void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
   if (item) {
     mBoard.getGraphicsScene().removeItem(*item);
   }
+  mBoard.getSpatialIndex().removeItem(*this);
   mIsAddedToBoard = false;
 }
 
+void BI_Base::invalidateSpatialIndex() noexcept {
+  // must be called whenever the grab area of the item has changed
+  if (mIsAddedToBoard) {
+    mBoard.getSpatialIndex().invalidateItem(*this);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
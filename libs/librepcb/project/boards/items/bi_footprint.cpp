@@ -26,6 +26,7 @@
 #include "../../library/projectlibrary.h"
 #include "../../project.h"
 #include "../board.h"
+#include "../boardlayerstack.h"
 #include "../cmd/cmdfootprintstroketextsreset.h"
 #include "bi_device.h"
 #include "bi_footprintpad.h"
@@ -108,6 +109,10 @@ void BI_Footprint::init() {
           &BI_Footprint::deviceInstanceRotated);
   connect(&mDevice, &BI_Device::mirrored, this,
           &BI_Footprint::deviceInstanceMirrored);
+
+  // the grab area depends on the visibility of some layers
+  connect(&mBoard.getLayerStack(), &BoardLayerStack::layerVisibilityChanged,
+          this, &BI_Footprint::layerVisibilityChanged);
 }
 
 BI_Footprint::~BI_Footprint() noexcept {
@@ -279,12 +284,14 @@ void BI_Footprint::setSelected(bool selected) noexcept {
 
 void BI_Footprint::deviceInstanceAttributesChanged() {
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
   emit attributesChanged();
 }
 
 void BI_Footprint::deviceInstanceMoved(const Point& pos) {
   mGraphicsItem->setPos(pos.toPxQPointF());
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -296,6 +303,7 @@ void BI_Footprint::deviceInstanceRotated(const Angle& rot) {
   Q_UNUSED(rot);
   updateGraphicsItemTransform();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -306,12 +314,18 @@ void BI_Footprint::deviceInstanceMirrored(bool mirrored) {
   Q_UNUSED(mirrored);
   updateGraphicsItemTransform();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
   }
 }
 
+void BI_Footprint::layerVisibilityChanged() {
+  mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
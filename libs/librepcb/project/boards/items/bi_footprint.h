@@ -124,6 +124,7 @@ private slots:
   void deviceInstanceMoved(const Point& pos);
   void deviceInstanceRotated(const Angle& rot);
   void deviceInstanceMirrored(bool mirrored);
+  void layerVisibilityChanged();
 
 signals:
   /// @copydoc AttributeProvider::attributesChanged()
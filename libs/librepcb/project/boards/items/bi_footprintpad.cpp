@@ -182,6 +182,7 @@ void BI_FootprintPad::updatePosition() noexcept {
   mGraphicsItem->setPos(mPosition.toPxQPointF());
   updateGraphicsItemTransform();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
   foreach (BI_NetLine* netline, mRegisteredNetLines) { netline->updateLine(); }
 }
 
@@ -220,6 +221,7 @@ Path BI_FootprintPad::getSceneOutline(const Length& expansion) const noexcept {
 
 void BI_FootprintPad::footprintAttributesChanged() {
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
 }
 
 void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from,
@@ -224,6 +224,7 @@ void BI_NetLine::setWidth(const PositiveLength& width) noexcept {
   if (width != mWidth) {
     mWidth = width;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateSpatialIndex();
   }
 }
 
@@ -264,6 +265,7 @@ void BI_NetLine::removeFromBoard() {
 void BI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
 }
 
 void BI_NetLine::serialize(SExpression& root) const {
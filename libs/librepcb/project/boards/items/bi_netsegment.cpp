@@ -208,51 +208,6 @@ bool BI_NetSegment::isUsed() const noexcept {
           (!mNetLines.isEmpty()));
 }
 
-int BI_NetSegment::getViasAtScenePos(const Point&    pos,
-                                     QList<BI_Via*>& vias) const noexcept {
-  int count = 0;
-  foreach (BI_Via* via, mVias) {
-    if (via->isSelectable() &&
-        via->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
-      vias.append(via);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int BI_NetSegment::getNetPointsAtScenePos(const Point&         pos,
-                                          const GraphicsLayer* layer,
-                                          QList<BI_NetPoint*>& points) const
-    noexcept {
-  int count = 0;
-  foreach (BI_NetPoint* netpoint, mNetPoints) {
-    if (netpoint->isSelectable() &&
-        netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-        ((!layer) || (netpoint->getLayerOfLines() == layer))) {
-      points.append(netpoint);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int BI_NetSegment::getNetLinesAtScenePos(const Point&         pos,
-                                         const GraphicsLayer* layer,
-                                         QList<BI_NetLine*>&  lines) const
-    noexcept {
-  int count = 0;
-  foreach (BI_NetLine* netline, mNetLines) {
-    if (netline->isSelectable() &&
-        netline->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-        ((!layer) || (&netline->getLayer() == layer))) {
-      lines.append(netline);
-      ++count;
-    }
-  }
-  return count;
-}
-
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -497,18 +452,6 @@ void BI_NetSegment::removeFromBoard() {
   sgl.dismiss();
 }
 
-void BI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept {
-  foreach (BI_Via* via, mVias)
-    via->setSelected(via->isSelectable() &&
-                     via->getGrabAreaScenePx().intersects(rectPx));
-  foreach (BI_NetPoint* netpoint, mNetPoints)
-    netpoint->setSelected(netpoint->isSelectable() &&
-                          netpoint->getGrabAreaScenePx().intersects(rectPx));
-  foreach (BI_NetLine* netline, mNetLines)
-    netline->setSelected(netline->isSelectable() &&
-                         netline->getGrabAreaScenePx().intersects(rectPx));
-}
-
 void BI_NetSegment::clearSelection() const noexcept {
   foreach (BI_Via* via, mVias)
     via->setSelected(false);
@@ -73,11 +73,6 @@ public:
   const Uuid& getUuid() const noexcept { return mUuid; }
   NetSignal&  getNetSignal() const noexcept { return *mNetSignal; }
   bool        isUsed() const noexcept;
-  int getViasAtScenePos(const Point& pos, QList<BI_Via*>& vias) const noexcept;
-  int getNetPointsAtScenePos(const Point& pos, const GraphicsLayer* layer,
-                             QList<BI_NetPoint*>& points) const noexcept;
-  int getNetLinesAtScenePos(const Point& pos, const GraphicsLayer* layer,
-                            QList<BI_NetLine*>& lines) const noexcept;
 
   // Setters
   void setNetSignal(NetSignal& netsignal);
@@ -107,7 +102,6 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
-  void setSelectionRect(const QRectF rectPx) noexcept;
   void clearSelection() const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
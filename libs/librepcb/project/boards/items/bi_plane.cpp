@@ -107,6 +107,8 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid,
 
 void BI_Plane::init() {
   mGraphicsItem.reset(new BGI_Plane(*this));
+  mFragmentsBuilder.reset(new BoardPlaneFragmentsBuilder(*this));
+  mFragmentsIndex.setPaths(mFragments);
   mGraphicsItem->setPos(getPosition().toPxQPointF());
   mGraphicsItem->setRotation(Angle::deg0().toDeg());
 
@@ -116,9 +118,18 @@ void BI_Plane::init() {
 }
 
 BI_Plane::~BI_Plane() noexcept {
+  mFragmentsBuilder.reset();
   mGraphicsItem.reset();
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+BoardPlaneFragmentsBuilder& BI_Plane::getFragmentsBuilder() noexcept {
+  return *mFragmentsBuilder;
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -147,6 +158,9 @@ void BI_Plane::setNetSignal(NetSignal& netsignal) {
       auto sg = scopeGuard([&]() { mNetSignal->registerBoardPlane(*this); });
       netsignal.registerBoardPlane(*this);  // can throw
       sg.dismiss();
+      // rebuild() only schedules this if the fragments have changed
+      mBoard.scheduleAirWiresRebuild(mNetSignal);
+      mBoard.scheduleAirWiresRebuild(&netsignal);
     }
     mNetSignal = &netsignal;
   }
@@ -182,6 +196,15 @@ void BI_Plane::setKeepOrphans(bool keepOrphans) noexcept {
   }
 }
 
+void BI_Plane::setFragments(const QVector<Path>& fragments) noexcept {
+  if (fragments != mFragments) {
+    mFragments = fragments;
+    mFragmentsIndex.setPaths(mFragments);
+    mGraphicsItem->updateCacheAndRepaint();
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -207,14 +230,12 @@ void BI_Plane::removeFromBoard() {
 
 void BI_Plane::clear() noexcept {
   mFragments.clear();
+  mFragmentsIndex.setPaths(mFragments);
   mGraphicsItem->updateCacheAndRepaint();
 }
 
 void BI_Plane::rebuild() noexcept {
-  BoardPlaneFragmentsBuilder builder(*this);
-  mFragments = builder.buildFragments();
-  mGraphicsItem->updateCacheAndRepaint();
-  mBoard.scheduleAirWiresRebuild(mNetSignal);
+  setFragments(mFragmentsBuilder->buildFragments());
 }
 
 void BI_Plane::serialize(SExpression& root) const {
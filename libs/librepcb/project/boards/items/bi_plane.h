@@ -27,6 +27,7 @@
 
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/geometry/pathcontainmentindex.h>
 #include <librepcb/common/graphics/graphicslayername.h>
 #include <librepcb/common/uuid.h>
 
@@ -42,6 +43,7 @@ class Project;
 class NetSignal;
 class Board;
 class BGI_Plane;
+class BoardPlaneFragmentsBuilder;
 
 /*******************************************************************************
  *  Class BI_Plane
@@ -87,9 +89,15 @@ public:
   // const Length& getThermalGapWidth() const noexcept {return
   // mThermalGapWidth;} const Length& getThermalSpokeWidth() const noexcept
   // {return mThermalSpokeWidth;}
-  const Path&          getOutline() const noexcept { return mOutline; }
-  const QVector<Path>& getFragments() const noexcept { return mFragments; }
-  bool                 isSelectable() const noexcept override;
+  const Path&                 getOutline() const noexcept { return mOutline; }
+  const QVector<Path>&        getFragments() const noexcept {
+    return mFragments;
+  }
+  const PathContainmentIndex& getFragmentsIndex() const noexcept {
+    return mFragmentsIndex;
+  }
+  BoardPlaneFragmentsBuilder& getFragmentsBuilder() noexcept;
+  bool                        isSelectable() const noexcept override;
 
   // Setters
   void setOutline(const Path& outline) noexcept;
@@ -100,6 +108,7 @@ public:
   void setConnectStyle(ConnectStyle style) noexcept;
   void setPriority(int priority) noexcept;
   void setKeepOrphans(bool keepOrphans) noexcept;
+  void setFragments(const QVector<Path>& fragments) noexcept;
 
   // General Methods
   void addToBoard() override;
@@ -146,7 +155,10 @@ private:  // Data
   // style [round square miter] ?
   QScopedPointer<BGI_Plane> mGraphicsItem;
 
-  QVector<Path> mFragments;
+  /// Kept across rebuilds to reuse cached cut-outs of unchanged objects
+  QScopedPointer<BoardPlaneFragmentsBuilder> mFragmentsBuilder;
+  QVector<Path>                              mFragments;
+  PathContainmentIndex                       mFragmentsIndex;
 };
 
 /*******************************************************************************
@@ -113,9 +113,11 @@ private:  // Methods
   void strokeTextPositionChanged(const Point& newPos) noexcept override {
     Q_UNUSED(newPos);
     updateGraphicsItems();
+    invalidateSpatialIndex();
   }
   void strokeTextRotationChanged(const Angle& newRot) noexcept override {
     Q_UNUSED(newRot);
+    invalidateSpatialIndex();
   }
   void strokeTextHeightChanged(
       const PositiveLength& newHeight) noexcept override {
@@ -138,12 +140,14 @@ private:  // Methods
   }
   void strokeTextMirroredChanged(bool mirrored) noexcept override {
     Q_UNUSED(mirrored);
+    invalidateSpatialIndex();
   }
   void strokeTextAutoRotateChanged(bool newAutoRotate) noexcept override {
     Q_UNUSED(newAutoRotate);
   }
   void strokeTextPathsChanged(const QVector<Path>& paths) noexcept override {
     Q_UNUSED(paths);
+    invalidateSpatialIndex();
   }
 
 private:  // Data
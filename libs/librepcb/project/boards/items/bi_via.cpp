@@ -144,6 +144,7 @@ void BI_Via::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
+    invalidateSpatialIndex();
     foreach (BI_NetLine* netline, mRegisteredNetLines) {
       netline->updateLine();
     }
@@ -155,6 +156,7 @@ void BI_Via::setShape(Shape shape) noexcept {
   if (shape != mShape) {
     mShape = shape;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateSpatialIndex();
   }
 }
 
@@ -162,6 +164,7 @@ void BI_Via::setSize(const PositiveLength& size) noexcept {
   if (size != mSize) {
     mSize = size;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateSpatialIndex();
   }
 }
 
@@ -169,6 +172,7 @@ void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
   if (diameter != mDrillDiameter) {
     mDrillDiameter = diameter;
     mGraphicsItem->updateCacheAndRepaint();
+    invalidateSpatialIndex();
   }
 }
 
@@ -204,6 +208,7 @@ void BI_Via::registerNetLine(BI_NetLine& netline) {
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
 }
 
 void BI_Via::unregisterNetLine(BI_NetLine& netline) {
@@ -213,6 +218,7 @@ void BI_Via::unregisterNetLine(BI_NetLine& netline) {
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
   mGraphicsItem->updateCacheAndRepaint();
+  invalidateSpatialIndex();
 }
 
 void BI_Via::serialize(SExpression& root) const {
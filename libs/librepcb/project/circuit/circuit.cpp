@@ -389,13 +389,14 @@ void Circuit::setComponentInstanceName(ComponentInstance&       cmp,
  *  General Methods
  ******************************************************************************/
 
-bool Circuit::save(bool toOriginal, QStringList& errors) noexcept {
+bool Circuit::save(bool toOriginal, QStringList& errors,
+                   AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   // Save "circuit/circuit.lp"
   try {
     SExpression doc(serializeToDomElement("librepcb_circuit"));
-    mFile->save(doc, toOriginal);
+    mFile->save(std::move(doc), toOriginal, writer);
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -38,6 +38,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class SmartSExprFile;
 
 namespace library {
@@ -125,7 +126,8 @@ public:
                                 const CircuitIdentifier& newName);
 
   // General Methods
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
 
   // Operator Overloadings
   Circuit& operator=(const Circuit& rhs) = delete;
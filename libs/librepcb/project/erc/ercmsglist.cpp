@@ -108,13 +108,14 @@ void ErcMsgList::restoreIgnoreState() {
   }
 }
 
-bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept {
+bool ErcMsgList::save(bool toOriginal, QStringList& errors,
+                      AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   // Save "circuit/erc.lp"
   try {
     SExpression doc(serializeToDomElement("librepcb_erc"));
-    mFile->save(doc, toOriginal);
+    mFile->save(std::move(doc), toOriginal, writer);
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -34,6 +34,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class SmartSExprFile;
 
 namespace project {
@@ -68,7 +69,8 @@ public:
   void remove(ErcMsg* ercMsg) noexcept;
   void update(ErcMsg* ercMsg) noexcept;
   void restoreIgnoreState();
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
 
   // Operator Overloadings
   ErcMsgList& operator=(const ErcMsgList& rhs) = delete;
@@ -33,6 +33,7 @@
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/sym/symbol.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -62,11 +63,14 @@ ProjectLibrary::ProjectLibrary(const FilePath& libDir, bool restore,
     // Load all library elements
     const FilePath& dirToLoad =
         restore && mBackupPath.isExistingDir() ? mBackupPath : mLibraryPath;
-    loadElements<Symbol>(dirToLoad.getPathTo("sym"), "symbols", mSymbols);
-    loadElements<Package>(dirToLoad.getPathTo("pkg"), "packages", mPackages);
+    loadElements<Symbol>(dirToLoad.getPathTo("sym"), "symbols", readOnly,
+                         mSymbols);
+    loadElements<Package>(dirToLoad.getPathTo("pkg"), "packages", readOnly,
+                          mPackages);
     loadElements<Component>(dirToLoad.getPathTo("cmp"), "components",
-                            mComponents);
-    loadElements<Device>(dirToLoad.getPathTo("dev"), "devices", mDevices);
+                            readOnly, mComponents);
+    loadElements<Device>(dirToLoad.getPathTo("dev"), "devices", readOnly,
+                         mDevices);
   } catch (const Exception&) {
     qDeleteAll(mAllElements);
     mAllElements.clear();
@@ -161,7 +165,8 @@ bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept {
     FilePath dir = libDir.getPathTo(element->getShortElementName())
                        .getPathTo(element->getUuid().toStr());
     try {
-      FileUtils::removeDirRecursively(dir);  // can throw
+      detachElementFromDirectory(*element, dir);  // can throw
+      FileUtils::removeDirRecursively(dir);       // can throw
       savedElements.remove(element);
     } catch (const Exception& e) {
       success = false;
@@ -179,11 +184,14 @@ bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept {
         element->save();  // can throw
         mLoadedElements.remove(element);
       }
-      if (dir.isExistingDir()) {
-        // Avoid copy failure caused by already existing directory.
-        FileUtils::removeDirRecursively(dir);
+      if (element->getFilePath() != dir) {
+        if (dir.isExistingDir()) {
+          // Avoid copy failure caused by already existing directory.
+          FileUtils::removeDirRecursively(dir);
+        }
+        FileUtils::copyDirRecursively(element->getFilePath(),
+                                      dir);  // can throw
       }
-      FileUtils::copyDirRecursively(element->getFilePath(), dir);  // can throw
       savedElements.insert(element);
     } catch (const Exception& e) {
       success = false;
@@ -207,9 +215,20 @@ QSet<LibraryBaseElement*> ProjectLibrary::getCurrentElements() const noexcept {
   return currentElements;
 }
 
+void ProjectLibrary::detachElementFromDirectory(LibraryBaseElement& element,
+                                                const FilePath&     dir) {
+  if (element.getFilePath() == dir) {
+    // The element was loaded directly from the directory which is going to be
+    // removed, thus copy it to the temporary directory first (copy-on-write).
+    element.saveIntoParentDirectory(
+        mTmpDir.getPathTo(QString::number(qrand())));  // can throw
+  }
+}
+
 template <typename ElementType>
 void ProjectLibrary::loadElements(const FilePath&            directory,
                                   const QString&             type,
+                                  bool                       readOnly,
                                   QHash<Uuid, ElementType*>& elementList) {
   QDir dir(directory.toStr());
 
@@ -217,6 +236,7 @@ void ProjectLibrary::loadElements(const FilePath&            directory,
   dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Readable);
   dir.setNameFilters(QStringList()
                      << QString("*.%1").arg(directory.getBasename()));
+  QList<LoadJob<ElementType>> jobs;
   foreach (const QString& dirname, dir.entryList()) {
     FilePath subdirPath(directory.getPathTo(dirname));
 
@@ -233,32 +253,54 @@ void ProjectLibrary::loadElements(const FilePath&            directory,
       continue;
     }
 
-    // Copy element to temporary directory to decouple it from the project
-    // library.
-    FilePath elementDir =
-        mTmpDir.getPathTo(QString::number(qrand())).getPathTo(dirname);
-    FileUtils::copyDirRecursively(subdirPath, elementDir);  // can throw
+    // Load the library element directly from the project library. It is only
+    // copied to the temporary directory if its directory needs to be removed
+    // while the element still exists, see detachElementFromDirectory().
+    jobs.append(LoadJob<ElementType>{subdirPath, readOnly,
+                                     QThread::currentThread(), nullptr});
+  }
+
+  // Parsing the elements is independent of each other, so they are loaded
+  // concurrently in the thread pool. If any element fails to load, all other
+  // elements are still loaded before the exception is rethrown here.
+  try {
+    QtConcurrent::blockingMap(
+        jobs, &ProjectLibrary::loadElement<ElementType>);  // can throw
+  } catch (...) {
+    foreach (const LoadJob<ElementType>& job, jobs) { delete job.element; }
+    throw;
+  }
+
+  // Take ownership of all elements before anything else can throw.
+  foreach (const LoadJob<ElementType>& job, jobs) {
+    mAllElements.insert(job.element);
+    mLoadedElements.insert(job.element);
+  }
 
-    // load the library element
-    QScopedPointer<ElementType> element(
-        new ElementType(elementDir, false));  // can throw
-    if (elementList.contains(element->getUuid())) {
+  // Add the elements in the order of the directory listing to get a
+  // deterministic result, independent of the order the jobs finished.
+  foreach (const LoadJob<ElementType>& job, jobs) {
+    if (elementList.contains(job.element->getUuid())) {
       throw RuntimeError(
           __FILE__, __LINE__,
           QString(tr("There are multiple library elements with the same "
                      "UUID in the directory \"%1\""))
-              .arg(subdirPath.toNative()));
+              .arg(job.directory.toNative()));
     }
-
-    // everything is ok -> update members
-    elementList.insert(element->getUuid(), element.data());
-    mAllElements.insert(element.data());
-    mLoadedElements.insert(element.take());  // Take object from smart pointer!
+    elementList.insert(job.element->getUuid(), job.element);
   }
 
   qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
 }
 
+template <typename ElementType>
+void ProjectLibrary::loadElement(LoadJob<ElementType>& job) {
+  // Attention: This method is executed in a thread pool, do not access any
+  // members of the project library here!
+  job.element = new ElementType(job.directory, job.readOnly);  // can throw
+  job.element->moveToThread(job.thread);  // back to the calling thread
+}
+
 template <typename ElementType>
 void ProjectLibrary::addElement(ElementType&               element,
                                 QHash<Uuid, ElementType*>& elementList) {
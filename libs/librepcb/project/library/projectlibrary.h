@@ -53,6 +53,13 @@ class Project;
 /**
  * @brief The ProjectLibrary class
  *
+ * Library elements are loaded directly from the project's library directory
+ * (or its backup). Elements added by the user are copied to a temporary
+ * directory to freeze their state. Loaded elements are only copied to the
+ * temporary directory when their directory is removed while saving the
+ * project (e.g. because the element was removed, but might be added again by
+ * undoing the removal).
+ *
  * @todo Adding and removing elements is very provisional. It does not really
  * work together with the automatic backup/restore feature of projects.
  */
@@ -107,6 +114,18 @@ public:
   // General Methods
   bool save(bool toOriginal, QStringList& errors) noexcept;
 
+private:  // Types
+  /**
+   * @brief A library element to be loaded in the thread pool
+   */
+  template <typename ElementType>
+  struct LoadJob {
+    FilePath     directory;  ///< The directory to load the element from
+    bool         readOnly;   ///< Whether to open the element read-only
+    QThread*     thread;     ///< The thread to move the loaded element to
+    ElementType* element;    ///< The loaded element (nullptr if not loaded)
+  };
+
 private:
   // make some methods inaccessible...
   ProjectLibrary();
@@ -115,9 +134,13 @@ private:
 
   // Private Methods
   QSet<library::LibraryBaseElement*> getCurrentElements() const noexcept;
+  void detachElementFromDirectory(library::LibraryBaseElement& element,
+                                  const FilePath&              dir);
   template <typename ElementType>
   void loadElements(const FilePath& directory, const QString& type,
-                    QHash<Uuid, ElementType*>& elementList);
+                    bool readOnly, QHash<Uuid, ElementType*>& elementList);
+  template <typename ElementType>
+  static void loadElement(LoadJob<ElementType>& job);
   template <typename ElementType>
   void addElement(ElementType& element, QHash<Uuid, ElementType*>& elementList);
   template <typename ElementType>
@@ -127,7 +150,7 @@ private:
   // General
   FilePath mLibraryPath;  ///< the "library" directory of the project
   FilePath mBackupPath;   ///< same as #mLibraryPath, but with trailing "~"
-  FilePath mTmpDir;       ///< path to a temporary directory
+  FilePath mTmpDir;       ///< path to a temporary directory for copies
 
   // The currently added library elements
   QHash<Uuid, library::Symbol*>    mSymbols;
@@ -64,8 +64,8 @@ ProjectMetadata::ProjectMetadata(Project& project, bool restore, bool readOnly,
     mFile.reset(new SmartSExprFile(mFilepath, restore, readOnly));
     SExpression root = mFile->parseFileAndBuildDomTree();
 
-    if (root.getChildByIndex(0)
-            .isString()) {  // backward compatibility, remove this some time!
+    // backward compatibility, remove this some time!
+    if (!root.getChildByIndex(0).isList()) {
       mUuid = root.getChildByIndex(0).getValue<Uuid>();
     }
     mName    = root.getValueByPath<ElementName>("name");
@@ -125,12 +125,13 @@ void ProjectMetadata::updateLastModified() noexcept {
  *  General Methods
  ******************************************************************************/
 
-bool ProjectMetadata::save(bool toOriginal, QStringList& errors) noexcept {
+bool ProjectMetadata::save(bool toOriginal, QStringList& errors,
+                           AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   try {
     SExpression doc(serializeToDomElement("librepcb_project_metadata"));
-    mFile->save(doc, toOriginal);
+    mFile->save(std::move(doc), toOriginal, writer);
   } catch (const Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -35,6 +35,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class SmartSExprFile;
 
 namespace project {
@@ -154,7 +155,8 @@ public:
   void updateLastModified() noexcept;
 
   // General Methods
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
 
   // Operator Overloadings
   ProjectMetadata& operator=(const ProjectMetadata& rhs) = delete;
@@ -33,6 +33,7 @@
 
 #include <librepcb/common/application.h>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/asyncsexprfilewriter.h>
 #include <librepcb/common/fileio/directorylock.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/sexpression.h>
@@ -41,7 +42,9 @@
 #include <librepcb/common/fileio/smartversionfile.h>
 #include <librepcb/common/font/strokefontpool.h>
 
+#include <QPicture>
 #include <QPrinter>
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -532,7 +535,8 @@ void Project::removeSchematic(Schematic& schematic, bool deleteSchematic) {
   }
 }
 
-void Project::exportSchematicsAsPdf(const FilePath& filepath) {
+int Project::exportSchematicsAsPdf(const FilePath& filepath,
+                                   bool            skipIfUnchanged) {
   // Create output directory first because QPrinter silently fails if it doesn't
   // exist.
   FileUtils::makePath(filepath.getParentDir());  // can throw
@@ -546,34 +550,47 @@ void Project::exportSchematicsAsPdf(const FilePath& filepath) {
 
   QList<int> pages;
   for (int i = 0; i < mSchematics.count(); i++) pages.append(i);
-
-  printSchematicPages(printer, pages);
-}
-
-void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) {
-  if (pages.isEmpty())
-    throw RuntimeError(__FILE__, __LINE__, tr("No schematic pages selected."));
-
-  QPainter painter(&printer);
-
-  for (int i = 0; i < pages.count(); i++) {
-    Schematic* schematic = getSchematicByIndex(pages[i]);
-    if (!schematic) {
-      throw RuntimeError(
-          __FILE__, __LINE__,
-          QString(tr("No schematic page with the index %1 found."))
-              .arg(pages[i]));
+  QList<QPicture> pictures = recordSchematicPages(printer, pages);  // can throw
+
+  // If requested, compare the fingerprints of the recorded pages with the
+  // fingerprints of the last export to skip writing an unchanged PDF. The
+  // recordings of large pages can be quite big, so they are hashed
+  // concurrently. Note that always the whole document is written since the
+  // pages of an existing PDF cannot be replaced.
+  if (skipIfUnchanged) {
+    QList<QByteArray> fingerprints =
+        QtConcurrent::blockingMapped<QList<QByteArray>>(
+            pictures, &Project::calcSchematicPageFingerprint);
+    SExpression root =
+        SExpression::createList("librepcb_schematic_fingerprints");
+    for (int i = 0; i < pages.count(); i++) {
+      SExpression& node = root.appendList("page", true);
+      node.appendChild(getSchematicByIndex(pages[i])->getUuid());
+      node.appendChild(QString(fingerprints[i].toHex()));
     }
-    schematic->clearSelection();
-    schematic->renderToQPainter(painter);
-
-    if (i != pages.count() - 1) {
-      if (!printer.newPage()) {
-        throw RuntimeError(__FILE__, __LINE__,
-                           tr("Unknown error while printing."));
-      }
+    QByteArray fingerprintsContent = root.toByteArray();  // can throw
+    FilePath   fingerprintsFp(filepath.toStr() % ".fingerprints");
+    if (filepath.isExistingFile() && fingerprintsFp.isExistingFile() &&
+        (FileUtils::readFile(fingerprintsFp) == fingerprintsContent)) {
+      return 0;  // nothing has changed, keep the existing file
+    }
+    if (fingerprintsFp.isExistingFile()) {
+      // remove outdated fingerprints in case printing fails
+      FileUtils::removeFile(fingerprintsFp);  // can throw
+    }
+    if (!pictures.isEmpty()) {
+      printSchematicPictures(printer, pictures);  // can throw
     }
+    FileUtils::writeFile(fingerprintsFp, fingerprintsContent);  // can throw
+  } else if (!pictures.isEmpty()) {
+    printSchematicPictures(printer, pictures);  // can throw
   }
+  return pictures.count();
+}
+
+void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) {
+  QList<QPicture> pictures = recordSchematicPages(printer, pages);  // can throw
+  printSchematicPictures(printer, pictures);                        // can throw
 }
 
 /*******************************************************************************
@@ -690,12 +707,18 @@ void Project::removeBoard(Board& board, bool deleteBoard) {
 void Project::save(bool toOriginal) {
   QStringList errors;
 
-  if (!save(toOriginal, errors)) {
-    QString msg =
-        QString(tr("The project could not be saved!\n\nError Message:\n%1",
-                   "variable count of error messages", errors.count()))
-            .arg(errors.join("\n"));
-    throw RuntimeError(__FILE__, __LINE__, msg);
+  if (!save(toOriginal, errors, nullptr)) {
+    throwSaveErrors(errors);
+  }
+  Q_ASSERT(errors.isEmpty());
+}
+
+void Project::autosave(AsyncSExprFileWriter& writer) {
+  QStringList errors;
+  bool        success = save(false, errors, &writer);
+  writer.start();  // can throw
+  if (!success) {
+    throwSaveErrors(errors);
   }
   Q_ASSERT(errors.isEmpty());
 }
@@ -779,7 +802,8 @@ Version Project::getProjectFileFormatVersion(const FilePath& dir) {
  *  Private Methods
  ******************************************************************************/
 
-bool Project::save(bool toOriginal, QStringList& errors) noexcept {
+bool Project::save(bool toOriginal, QStringList& errors,
+                   AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   if (mIsReadOnly) {
@@ -811,7 +835,7 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept {
       root.appendChild("schematic", schematic->getFilePath().toRelative(mPath),
                        true);
     }
-    mSchematicsFile->save(root, toOriginal);  // can throw
+    mSchematicsFile->save(std::move(root), toOriginal, writer);  // can throw
   } catch (const Exception& e) {
     success = false;
     errors.append(e.getMsg());
@@ -823,44 +847,44 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept {
     foreach (Board* board, mBoards) {
       root.appendChild("board", board->getFilePath().toRelative(mPath), true);
     }
-    mBoardsFile->save(root, toOriginal);  // can throw
+    mBoardsFile->save(std::move(root), toOriginal, writer);  // can throw
   } catch (const Exception& e) {
     success = false;
     errors.append(e.getMsg());
   }
 
   // Save metadata
-  if (!mProjectMetadata->save(toOriginal, errors)) success = false;
+  if (!mProjectMetadata->save(toOriginal, errors, writer)) success = false;
 
   // Save circuit
-  if (!mCircuit->save(toOriginal, errors)) success = false;
+  if (!mCircuit->save(toOriginal, errors, writer)) success = false;
 
   // Save all removed schematics (*.lp files)
   foreach (Schematic* schematic, mRemovedSchematics) {
-    if (!schematic->save(toOriginal, errors)) success = false;
+    if (!schematic->save(toOriginal, errors, writer)) success = false;
   }
   // Save all added schematics (*.lp files)
   foreach (Schematic* schematic, mSchematics) {
-    if (!schematic->save(toOriginal, errors)) success = false;
+    if (!schematic->save(toOriginal, errors, writer)) success = false;
   }
 
   // Save all removed boards (*.lp files)
   foreach (Board* board, mRemovedBoards) {
-    if (!board->save(toOriginal, errors)) success = false;
+    if (!board->save(toOriginal, errors, writer)) success = false;
   }
   // Save all added boards (*.lp files)
   foreach (Board* board, mBoards) {
-    if (!board->save(toOriginal, errors)) success = false;
+    if (!board->save(toOriginal, errors, writer)) success = false;
   }
 
   // Save library
   if (!mProjectLibrary->save(toOriginal, errors)) success = false;
 
   // Save settings
-  if (!mProjectSettings->save(toOriginal, errors)) success = false;
+  if (!mProjectSettings->save(toOriginal, errors, writer)) success = false;
 
   // Save ERC messages list
-  if (!mErcMsgList->save(toOriginal, errors)) success = false;
+  if (!mErcMsgList->save(toOriginal, errors, writer)) success = false;
 
   // if the project was restored from a backup, reset the mIsRestored flag as
   // the current state of the project is no longer a restored backup but a
@@ -873,6 +897,65 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept {
   return success;
 }
 
+void Project::throwSaveErrors(const QStringList& errors) const {
+  QString msg =
+      QString(tr("The project could not be saved!\n\nError Message:\n%1",
+                 "variable count of error messages", errors.count()))
+          .arg(errors.join("\n"));
+  throw RuntimeError(__FILE__, __LINE__, msg);
+}
+
+QList<QPicture> Project::recordSchematicPages(const QPrinter&   printer,
+                                              const QList<int>& pages) const {
+  if (pages.isEmpty())
+    throw RuntimeError(__FILE__, __LINE__, tr("No schematic pages selected."));
+
+  // Record all pages first, so the (slow) PDF/printer output is decoupled from
+  // the graphics scenes. Note that the graphics scenes are not thread-safe, so
+  // the recording must be done in this thread.
+  QRectF          target(0, 0, printer.width(), printer.height());
+  QList<QPicture> pictures;
+  for (int i = 0; i < pages.count(); i++) {
+    Schematic* schematic = getSchematicByIndex(pages[i]);
+    if (!schematic) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          QString(tr("No schematic page with the index %1 found."))
+              .arg(pages[i]));
+    }
+    schematic->clearSelection();
+    QPicture picture;
+    QPainter painter(&picture);
+    schematic->renderToQPainter(painter, target);
+    painter.end();
+    pictures.append(picture);
+  }
+  return pictures;
+}
+
+void Project::printSchematicPictures(QPrinter&              printer,
+                                     const QList<QPicture>& pictures) const {
+  QPainter painter(&printer);
+
+  for (int i = 0; i < pictures.count(); i++) {
+    painter.drawPicture(0, 0, pictures[i]);
+
+    if (i != pictures.count() - 1) {
+      if (!printer.newPage()) {
+        throw RuntimeError(__FILE__, __LINE__,
+                           tr("Unknown error while printing."));
+      }
+    }
+  }
+}
+
+QByteArray Project::calcSchematicPageFingerprint(
+    const QPicture& picture) noexcept {
+  return QCryptographicHash::hash(
+      QByteArray::fromRawData(picture.data(), picture.size()),
+      QCryptographicHash::Md5);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
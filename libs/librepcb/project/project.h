@@ -36,10 +36,12 @@
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
+class QPicture;
 class QPrinter;
 
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class SmartTextFile;
 class SmartSExprFile;
 class SmartVersionFile;
@@ -275,14 +277,22 @@ public:
   /**
    * @brief Export the schematic pages as a PDF
    *
-   * @param filepath  The filepath where the PDF should be saved. If the file
-   * exists already, it will be overwritten.
+   * @param filepath          The filepath where the PDF should be saved. If
+   *                          the file exists already, it will be overwritten.
+   * @param skipIfUnchanged   If true, the PDF is not written if no page has
+   *                          changed since the last export to the same file.
+   *                          If any page has changed, all pages are written.
+   *                          The fingerprints of the exported pages are
+   *                          stored in the file "<filepath>.fingerprints".
+   *
+   * @return The number of exported pages (if 0, no PDF was written)
    *
    * @throw Exception     On error
    *
    * @todo add more parameters (paper size, orientation, pages to print, ...)
    */
-  void exportSchematicsAsPdf(const FilePath& filepath);
+  int exportSchematicsAsPdf(const FilePath& filepath,
+                            bool            skipIfUnchanged = false);
 
   /**
    * @brief Print some schematics to a QPrinter (printer or file)
@@ -402,6 +412,23 @@ public:
    */
   void save(bool toOriginal);
 
+  /**
+   * @brief Save the whole project to the temporary files in the background
+   *
+   * The DOM trees of all files are built immediately (snapshot of the current
+   * state), but they are formatted and written to the temporary files by the
+   * passed writer in worker threads. Only files which cannot be snapshotted
+   * (e.g. library elements) are still copied immediately.
+   *
+   * @param writer    The writer to use (must not be running)
+   *
+   * @note The whole save procedere is described in @ref doc_project_save.
+   *
+   * @throw Exception on error (files which could be snapshotted are written
+   *                  anyway)
+   */
+  void autosave(AsyncSExprFileWriter& writer);
+
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getUserDefinedAttributeValue()
   QString getUserDefinedAttributeValue(const QString& key) const
@@ -485,11 +512,21 @@ private:
    * files
    * @param errors        All errors will be added to this string list
    * (translated)
+   * @param writer        If not nullptr, S-Expression files are not written
+   *                      immediately but passed to this writer
    *
    * @return True on success (then the error list should be empty), false
    * otherwise
    */
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
+  void throwSaveErrors(const QStringList& errors) const;
+  QList<QPicture> recordSchematicPages(const QPrinter&   printer,
+                                       const QList<int>& pages) const;
+  void printSchematicPictures(QPrinter&              printer,
+                              const QList<QPicture>& pictures) const;
+  static QByteArray calcSchematicPageFingerprint(
+      const QPicture& picture) noexcept;
 
   // Project File (*.lpp)
   FilePath mPath;      ///< the path to the project directory
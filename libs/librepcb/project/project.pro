@@ -26,7 +26,9 @@ SOURCES += \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
     boards/boardplanefragmentsbuilder.cpp \
+    boards/boardplanesrebuilder.cpp \
     boards/boardselectionquery.cpp \
+    boards/boardspatialindex.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
     boards/cmd/cmdboarddesignrulesmodify.cpp \
@@ -141,7 +143,9 @@ HEADERS += \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
     boards/boardplanefragmentsbuilder.h \
+    boards/boardplanesrebuilder.h \
     boards/boardselectionquery.h \
+    boards/boardspatialindex.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
     boards/cmd/cmdboarddesignrulesmodify.h \
@@ -22,6 +22,9 @@
  ******************************************************************************/
 #include "cmdschematicnetsegmentremove.h"
 
+#include "../items/si_netlabel.h"
+#include "../items/si_netline.h"
+#include "../items/si_netpoint.h"
 #include "../items/si_netsegment.h"
 #include "../schematic.h"
 
@@ -47,6 +50,20 @@ CmdSchematicNetSegmentRemove::CmdSchematicNetSegmentRemove(
 CmdSchematicNetSegmentRemove::~CmdSchematicNetSegmentRemove() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetSegmentRemove::getMemoryUsage() const noexcept {
+  // the removed net segment and all its elements are kept by this command
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdSchematicNetSegmentRemove) - sizeof(UndoCommand)) +
+         sizeof(SI_NetSegment) +
+         (mNetSegment.getNetPoints().count() * sizeof(SI_NetPoint)) +
+         (mNetSegment.getNetLines().count() * sizeof(SI_NetLine)) +
+         (mNetSegment.getNetLabels().count() * sizeof(SI_NetLabel));
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
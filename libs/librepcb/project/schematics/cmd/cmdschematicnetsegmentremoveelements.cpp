@@ -48,6 +48,17 @@ CmdSchematicNetSegmentRemoveElements::
     ~CmdSchematicNetSegmentRemoveElements() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetSegmentRemoveElements::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         (sizeof(CmdSchematicNetSegmentRemoveElements) - sizeof(UndoCommand)) +
+         (mNetPoints.count() * (sizeof(SI_NetPoint*) + sizeof(SI_NetPoint))) +
+         (mNetLines.count() * (sizeof(SI_NetLine*) + sizeof(SI_NetLine)));
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
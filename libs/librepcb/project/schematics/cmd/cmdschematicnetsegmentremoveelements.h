@@ -50,6 +50,11 @@ public:
   CmdSchematicNetSegmentRemoveElements(SI_NetSegment& segment) noexcept;
   ~CmdSchematicNetSegmentRemoveElements() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // General Methods
   void removeNetPoint(SI_NetPoint& netpoint);
   void removeNetLine(SI_NetLine& netline);
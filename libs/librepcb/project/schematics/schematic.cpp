@@ -80,7 +80,7 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
       // the schematic seems to be ready to open, so we will create all needed
       // objects
 
-      if (root.getChildByIndex(0).isString()) {
+      if (!root.getChildByIndex(0).isList()) {
         mUuid = root.getChildByIndex(0).getValue<Uuid>();
       } else {
         // backward compatibility, remove this some time!
@@ -355,14 +355,15 @@ void Schematic::removeFromProject() {
   sgl.dismiss();
 }
 
-bool Schematic::save(bool toOriginal, QStringList& errors) noexcept {
+bool Schematic::save(bool toOriginal, QStringList& errors,
+                     AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   // save schematic file
   try {
     if (mIsAddedToProject) {
       SExpression doc(serializeToDomElement("librepcb_schematic"));
-      mFile->save(doc, toOriginal);
+      mFile->save(std::move(doc), toOriginal, writer);
     } else {
       mFile->removeFile(toOriginal);
     }
@@ -408,8 +409,9 @@ void Schematic::updateAllNetLabelAnchors() noexcept {
   }
 }
 
-void Schematic::renderToQPainter(QPainter& painter) const noexcept {
-  mGraphicsScene->render(&painter, QRectF(),
+void Schematic::renderToQPainter(QPainter&     painter,
+                                 const QRectF& target) const noexcept {
+  mGraphicsScene->render(&painter, target,
                          mGraphicsScene->itemsBoundingRect(),
                          Qt::KeepAspectRatio);
 }
@@ -44,6 +44,7 @@ namespace librepcb {
 class GridProperties;
 class GraphicsView;
 class GraphicsScene;
+class AsyncSExprFileWriter;
 class SmartSExprFile;
 
 namespace project {
@@ -152,7 +153,8 @@ public:
   // General Methods
   void addToProject();
   void removeFromProject();
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
   void showInView(GraphicsView& view) noexcept;
   void saveViewSceneRect(const QRectF& rect) noexcept { mViewRect = rect; }
   const QRectF& restoreViewSceneRect() const noexcept { return mViewRect; }
@@ -160,7 +162,9 @@ public:
                                  bool updateItems) noexcept;
   void          clearSelection() const noexcept;
   void          updateAllNetLabelAnchors() noexcept;
-  void          renderToQPainter(QPainter& painter) const noexcept;
+  void          renderToQPainter(QPainter&     painter,
+                                 const QRectF& target = QRectF()) const
+      noexcept;
   std::unique_ptr<SchematicSelectionQuery> createSelectionQuery() const
       noexcept;
 
@@ -103,13 +103,14 @@ void ProjectSettings::triggerSettingsChanged() noexcept {
   emit settingsChanged();
 }
 
-bool ProjectSettings::save(bool toOriginal, QStringList& errors) noexcept {
+bool ProjectSettings::save(bool toOriginal, QStringList& errors,
+                           AsyncSExprFileWriter* writer) noexcept {
   bool success = true;
 
   // Save "project/settings.lp"
   try {
     SExpression doc(serializeToDomElement("librepcb_project_settings"));
-    mFile->save(doc, toOriginal);
+    mFile->save(std::move(doc), toOriginal, writer);
   } catch (Exception& e) {
     success = false;
     errors.append(e.getMsg());
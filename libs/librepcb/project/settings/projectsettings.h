@@ -33,6 +33,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class SmartSExprFile;
 
 namespace project {
@@ -74,7 +75,8 @@ public:
   // General Methods
   void restoreDefaults() noexcept;
   void triggerSettingsChanged() noexcept;
-  bool save(bool toOriginal, QStringList& errors) noexcept;
+  bool save(bool toOriginal, QStringList& errors,
+            AsyncSExprFileWriter* writer) noexcept;
 
 signals:
 
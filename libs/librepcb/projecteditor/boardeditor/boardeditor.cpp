@@ -37,6 +37,7 @@
 #include <librepcb/common/dialogs/boarddesignrulesdialog.h>
 #include <librepcb/common/dialogs/filedialog.h>
 #include <librepcb/common/dialogs/gridsettingsdialog.h>
+#include <librepcb/common/fileio/asyncsexprfilewriter.h>
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/gridproperties.h>
 #include <librepcb/common/undostack.h>
@@ -218,7 +219,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
 
   // setup status bar
   mUi->statusbar->setFields(StatusBar::AbsolutePosition |
-                            StatusBar::ProgressBar);
+                            StatusBar::ProgressBar | StatusBar::UndoMemory);
   mUi->statusbar->setProgressBarTextFormat(tr("Scanning libraries (%p%)"));
   connect(&mProjectEditor.getWorkspace().getLibraryDb(),
           &workspace::WorkspaceLibraryDb::scanStarted, mUi->statusbar,
@@ -231,6 +232,22 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
           &StatusBar::setProgressBarPercent, Qt::QueuedConnection);
   connect(mGraphicsView, &GraphicsView::cursorScenePositionChanged,
           mUi->statusbar, &StatusBar::setAbsoluteCursorPosition);
+  mUi->statusbar->setUndoMemoryUsage(
+      mProjectEditor.getUndoStack().getMemoryUsage());
+  connect(&mProjectEditor.getUndoStack(), &UndoStack::memoryUsageChanged,
+          mUi->statusbar, &StatusBar::setUndoMemoryUsage);
+  connect(&mProjectEditor.getAutosaveWriter(),
+          &AsyncSExprFileWriter::progressChanged, this, [this](int percent) {
+            mUi->statusbar->showMessage(
+                tr("Autosaving project (%1%)...").arg(percent));
+          });
+  connect(&mProjectEditor.getAutosaveWriter(), &AsyncSExprFileWriter::finished,
+          this, [this](const QStringList& errors) {
+            mUi->statusbar->showMessage(errors.isEmpty()
+                                            ? tr("Project autosaved")
+                                            : tr("Autosave failed!"),
+                                        5000);
+          });
 
   // Restore Window Geometry
   QSettings clientSettings;
@@ -77,6 +77,7 @@ FabricationOutputDialog::FabricationOutputDialog(Board& board, QWidget* parent)
   mUi->edtSuffixSolderPasteTop->setText(s.getSuffixSolderPasteTop());
   mUi->edtSuffixSolderPasteBot->setText(s.getSuffixSolderPasteBot());
   mUi->cbxDrillsMerge->setChecked(s.getMergeDrillFiles());
+  mUi->cbxDrillsOptimizePath->setChecked(s.getOptimizeDrillPath());
   mUi->cbxSolderPasteTop->setChecked(s.getEnableSolderPasteTop());
   mUi->cbxSolderPasteBot->setChecked(s.getEnableSolderPasteBot());
 
@@ -164,6 +165,7 @@ void FabricationOutputDialog::on_btnGenerate_clicked() {
     s.setSilkscreenLayersTop(getTopSilkscreenLayers());
     s.setSilkscreenLayersBot(getBotSilkscreenLayers());
     s.setMergeDrillFiles(mUi->cbxDrillsMerge->isChecked());
+    s.setOptimizeDrillPath(mUi->cbxDrillsOptimizePath->isChecked());
     s.setEnableSolderPasteTop(mUi->cbxSolderPasteTop->isChecked());
     s.setEnableSolderPasteBot(mUi->cbxSolderPasteBot->isChecked());
     if (s != mBoard.getFabricationOutputSettings()) {
@@ -172,7 +174,7 @@ void FabricationOutputDialog::on_btnGenerate_clicked() {
 
     // generate files
     BoardGerberExport grbExport(mBoard);
-    grbExport.exportAllLayers();
+    grbExport.exportAllLayers(true);  // can throw
   } catch (Exception& e) {
     QMessageBox::warning(this, tr("Error"), e.getMsg());
   }
@@ -156,7 +156,7 @@ BES_Base::ProcRetVal BES_AddDevice::processSceneEvent(
       // set temporary position of the current device
       Q_ASSERT(!mCurrentDeviceEditCmd.isNull());
       mCurrentDeviceEditCmd->setPosition(pos, true);
-      board->triggerAirWiresRebuild();
+      board->triggerAirWiresRebuildAsync();
       break;
     }
 
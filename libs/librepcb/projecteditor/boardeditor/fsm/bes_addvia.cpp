@@ -351,7 +351,7 @@ bool BES_AddVia::updateVia(Board& board, const Point& pos) noexcept {
     mViaEditCmd->setShape(mCurrentViaShape, true);
     mViaEditCmd->setSize(mCurrentViaSize, true);
     mViaEditCmd->setDrillDiameter(mCurrentViaDrillDiameter, true);
-    board.triggerAirWiresRebuild();
+    board.triggerAirWiresRebuildAsync();
     return true;
   } catch (Exception& e) {
     QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
@@ -656,8 +656,8 @@ void BES_DrawTrace::updateNetpointPositions(const Point& cursorPos) noexcept {
   mPositioningNetPoint2->setPosition(cursorPos);
 
   // Force updating airwires immediately as they are important for creating
-  // traces.
-  mPositioningNetPoint2->getBoard().triggerAirWiresRebuild();
+  // traces. They are calculated in the background to keep the cursor smooth.
+  mPositioningNetPoint2->getBoard().triggerAirWiresRebuildAsync();
 }
 
 void BES_DrawTrace::layerComboBoxIndexChanged(int index) noexcept {
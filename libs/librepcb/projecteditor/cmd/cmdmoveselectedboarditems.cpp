@@ -147,8 +147,8 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept {
     mDeltaPos = delta;
 
     // Force updating airwires immediately as they are important while moving
-    // items.
-    mBoard.triggerAirWiresRebuild();
+    // items. They are calculated in the background to keep moving smooth.
+    mBoard.triggerAirWiresRebuildAsync();
   }
 }
 
@@ -257,7 +257,7 @@ void AddComponentDialog::searchComponents(const QString& input) {
   if (input.length() >
       1) {  // avoid freeze on entering first character due to huge result
     const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
-    QSet<Uuid>         components =
+    QList<Uuid>        components =
         mWorkspace.getLibraryDb().getComponentsBySearchKeyword(input);
     foreach (const Uuid& cmpUuid, components) {
       // component
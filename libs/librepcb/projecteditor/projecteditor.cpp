@@ -27,6 +27,7 @@
 #include "dialogs/projectsettingsdialog.h"
 #include "schematiceditor/schematiceditor.h"
 
+#include <librepcb/common/fileio/asyncsexprfilewriter.h>
 #include <librepcb/common/undostack.h>
 #include <librepcb/project/project.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
@@ -49,11 +50,25 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
   : QObject(nullptr),
     mWorkspace(workspace),
     mProject(project),
+    mAutosaveWriter(new AsyncSExprFileWriter()),
     mUndoStack(nullptr),
     mSchematicEditor(nullptr),
     mBoardEditor(nullptr) {
+  connect(mAutosaveWriter.data(), &AsyncSExprFileWriter::finished, this,
+          [](const QStringList& errors) {
+            if (errors.isEmpty()) {
+              qDebug() << "Project successfully autosaved";
+            } else {
+              qCritical() << "Failed to autosave the project:" << errors;
+            }
+          });
+
   try {
     mUndoStack = new UndoStack();
+    const workspace::WSI_UndoHistoryLimits& undoLimits =
+        mWorkspace.getSettings().getUndoHistoryLimits();
+    mUndoStack->setMaxCommandCount(undoLimits.getMaxSteps());
+    mUndoStack->setMaxMemoryUsage(undoLimits.getMaxMemoryBytes());
 
     // create the whole schematic/board editor GUI inclusive FSM and so on
     mSchematicEditor = new SchematicEditor(*this, mProject);
@@ -81,8 +96,10 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
 }
 
 ProjectEditor::~ProjectEditor() noexcept {
-  // stop the autosave timer
+  // stop the autosave timer and wait until the last backup is written (must
+  // be done before the project removes its temporary files)
   mAutoSaveTimer.stop();
+  mAutosaveWriter->waitForFinished();
 
   // abort all active commands!
   mSchematicEditor->abortAllCommands();
@@ -167,6 +184,9 @@ void ProjectEditor::execNetClassesEditorDialog(QWidget* parent) noexcept {
 }
 
 bool ProjectEditor::saveProject() noexcept {
+  // a running autosave must not write the temporary files concurrently
+  mAutosaveWriter->waitForFinished();
+
   try {
     // step 1: save whole project to temporary files
     qDebug() << "Begin saving the project to temporary files...";
@@ -202,12 +222,17 @@ bool ProjectEditor::autosaveProject() noexcept {
     return false;
   }
 
+  if (mAutosaveWriter->isRunning()) {
+    qWarning() << "Previous autosave not finished yet, skipping this one.";
+    return false;
+  }
+
   try {
     qDebug() << "Begin autosaving the project to temporary files...";
-    mProject.save(false);
-    qDebug() << "Project successfully autosaved";
+    mProject.autosave(*mAutosaveWriter);  // can throw
     return true;
   } catch (Exception& exc) {
+    qCritical() << "Failed to autosave the project:" << exc.getMsg();
     return false;
   }
 }
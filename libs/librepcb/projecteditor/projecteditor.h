@@ -37,6 +37,7 @@ class QMainWindow;
 
 namespace librepcb {
 
+class AsyncSExprFileWriter;
 class UndoStack;
 
 namespace workspace {
@@ -92,6 +93,15 @@ public:
    */
   UndoStack& getUndoStack() const noexcept { return *mUndoStack; }
 
+  /**
+   * @brief Get the writer used to save automatic backups in the background
+   *
+   * @return A reference to the AsyncSExprFileWriter object
+   */
+  AsyncSExprFileWriter& getAutosaveWriter() const noexcept {
+    return *mAutosaveWriter;
+  }
+
   // General Methods
 
   /**
@@ -165,6 +175,10 @@ public slots:
   /**
    * @brief Make a automatic backup of the project (save to temporary files)
    *
+   * Only the snapshots of the files are created in this method, they are
+   * written in the background by #getAutosaveWriter(). If the previous backup
+   * is still being written, no new backup is made.
+   *
    * @note The whole save procedere is described in @ref doc_project_save.
    *
    * @return true on success, false on failure
@@ -212,6 +226,8 @@ private:  // Data
   Project&              mProject;
   QTimer mAutoSaveTimer;  ///< the timer for the periodically automatic saving
                           ///< functionality (see also @ref doc_project_save)
+  QScopedPointer<AsyncSExprFileWriter> mAutosaveWriter;  ///< writes backups
+
   UndoStack*       mUndoStack;        ///< See @ref doc_project_undostack
   SchematicEditor* mSchematicEditor;  ///< The schematic editor (GUI)
   BoardEditor*     mBoardEditor;      ///< The board editor (GUI)
@@ -48,8 +48,8 @@ FavoriteProjectsModel::FavoriteProjectsModel(
         mWorkspace.getMetadataPath().getPathTo("favorite_projects.lp");
     if (filepath.isExistingFile()) {
       mFile.reset(new SmartSExprFile(filepath, false, false));
-      SExpression               root   = mFile->parseFileAndBuildDomTree();
-      const QList<SExpression>& childs = root.getChildren("project");
+      SExpression                 root   = mFile->parseFileAndBuildDomTree();
+      const QVector<SExpression>& childs = root.getChildren("project");
       foreach (const SExpression& child, childs) {
         QString  path    = child.getValueOfFirstChild<QString>(true);
         FilePath absPath = FilePath::fromRelative(mWorkspace.getPath(), path);
@@ -53,7 +53,7 @@ using namespace library;
  ******************************************************************************/
 
 WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
-  : QObject(nullptr), mWorkspace(ws) {
+  : QObject(nullptr), mWorkspace(ws), mFullTextSearchAvailable(false) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -72,7 +72,15 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
     mDb.reset(new SQLiteDatabase(mFilePath));  // can throw
     createAllTables();                         // can throw
     setDbVersion(sCurrentDbVersion);           // can throw
+    try {
+      createFullTextSearchTables();  // can throw
+    } catch (const Exception& e) {
+      qWarning() << "Could not create full-text search index, falling back to"
+                    " slow search:"
+                 << e.getMsg();
+    }
   }
+  mFullTextSearchAvailable = isFullTextSearchAvailable();
 
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mWorkspace, mFilePath));
@@ -435,24 +443,58 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(
   return elements;
 }
 
-QSet<Uuid> WorkspaceLibraryDb::getComponentsBySearchKeyword(
+QList<Uuid> WorkspaceLibraryDb::getComponentsBySearchKeyword(
     const QString& keyword) const {
+  if (!mFullTextSearchAvailable) {
+    return getComponentsBySearchKeywordSlow(keyword);  // can throw
+  }
+
+  // Build the FTS5 query: Every whitespace separated token of the keyword must
+  // match (implicit AND) the beginning of any word in the name or keywords.
+  // The tokens are quoted to avoid interpreting them as FTS5 operators.
+  QStringList tokens;
+  QStringList words = keyword.split(QRegExp("\\s+"), QString::SkipEmptyParts);
+  foreach (QString token, words) {
+    tokens.append("\"" % token.replace("\"", "\"\"") % "\"*");
+  }
+  if (tokens.isEmpty()) {
+    return QList<Uuid>();
+  }
+
+  // Components are found either by their own translations or by the
+  // translations of their devices, ordered by the best BM25 rank of any match.
   QSqlQuery query = mDb->prepareQuery(
-      "SELECT components.uuid FROM components, components_tr, devices, "
-      "devices_tr "
-      "ON components.id=components_tr.component_id "
-      "AND devices.id=devices_tr.device_id "
-      "AND devices.component_uuid=components.uuid "
-      "WHERE components_tr.name LIKE :keyword "
-      "OR components_tr.keywords LIKE :keyword "
-      "OR devices_tr.name LIKE :keyword "
-      "OR devices_tr.keywords LIKE :keyword ");
-  query.bindValue(":keyword", "%" + keyword + "%");
+      "SELECT components.uuid FROM ("
+      "SELECT components_tr.component_id AS cmp_id, "
+      "bm25(components_tr_fts) AS score "
+      "FROM components_tr_fts "
+      "INNER JOIN components_tr ON components_tr.id=components_tr_fts.rowid "
+      "WHERE components_tr_fts MATCH :cmp_query "
+      "UNION ALL "
+      "SELECT components.id AS cmp_id, bm25(devices_tr_fts) AS score "
+      "FROM devices_tr_fts "
+      "INNER JOIN devices_tr ON devices_tr.id=devices_tr_fts.rowid "
+      "INNER JOIN devices ON devices.id=devices_tr.device_id "
+      "INNER JOIN components ON components.uuid=devices.component_uuid "
+      "WHERE devices_tr_fts MATCH :dev_query"
+      ") AS matches "
+      "INNER JOIN components ON components.id=matches.cmp_id "
+      "GROUP BY components.uuid "
+      "ORDER BY MIN(matches.score)");
+  query.bindValue(":cmp_query", tokens.join(" "));
+  query.bindValue(":dev_query", tokens.join(" "));
   mDb->exec(query);
 
-  QSet<Uuid> elements;
+  QList<Uuid> elements;
   while (query.next()) {
-    elements.insert(Uuid::fromString(query.value(0).toString()));  // can throw
+    elements.append(Uuid::fromString(query.value(0).toString()));  // can throw
+  }
+
+  // The full-text index only finds words starting with the keyword, but e.g.
+  // searching for "555" should also find "NE555". So if no component was
+  // found at all, fall back to the (slow) substring search.
+  if (elements.isEmpty()) {
+    return getComponentsBySearchKeywordSlow(keyword);  // can throw
   }
   return elements;
 }
@@ -469,6 +511,76 @@ void WorkspaceLibraryDb::startLibraryRescan() noexcept {
  *  Private Methods
  ******************************************************************************/
 
+QList<Uuid> WorkspaceLibraryDb::getComponentsBySearchKeywordSlow(
+    const QString& keyword) const {
+  QSqlQuery query = mDb->prepareQuery(
+      "SELECT DISTINCT components.uuid FROM components, components_tr, "
+      "devices, devices_tr "
+      "ON components.id=components_tr.component_id "
+      "AND devices.id=devices_tr.device_id "
+      "AND devices.component_uuid=components.uuid "
+      "WHERE components_tr.name LIKE :keyword "
+      "OR components_tr.keywords LIKE :keyword "
+      "OR devices_tr.name LIKE :keyword "
+      "OR devices_tr.keywords LIKE :keyword ");
+  query.bindValue(":keyword", "%" + keyword + "%");
+  mDb->exec(query);
+
+  QList<Uuid> elements;
+  while (query.next()) {
+    elements.append(Uuid::fromString(query.value(0).toString()));  // can throw
+  }
+  return elements;
+}
+
+bool WorkspaceLibraryDb::isFullTextSearchAvailable() const noexcept {
+  try {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' "
+        "AND name IN ('components_tr_fts', 'devices_tr_fts')");
+    mDb->exec(query);
+    return query.next() && (query.value(0).toInt() == 2);
+  } catch (const Exception& e) {
+    return false;
+  }
+}
+
+void WorkspaceLibraryDb::createFullTextSearchTables() {
+  // The FTS5 tables are "external content" tables referring to the
+  // translation tables, i.e. they only store the index but not the texts
+  // themselves. Triggers keep them in sync while the library scanner adds
+  // or removes elements (also for rows deleted by ON DELETE CASCADE).
+  QStringList queries;
+  foreach (const QString& table, QStringList({"components_tr", "devices_tr"})) {
+    queries << QString(
+        "CREATE VIRTUAL TABLE IF NOT EXISTS " % table %
+        "_fts USING fts5("
+        "name, keywords, content='" %
+        table %
+        "', content_rowid='id', "
+        "tokenize='unicode61 remove_diacritics 1'"
+        ")");
+    queries << QString(
+        "CREATE TRIGGER IF NOT EXISTS " % table %
+        "_fts_insert AFTER INSERT ON " % table % " BEGIN INSERT INTO " % table %
+        "_fts(rowid, name, keywords) "
+        "VALUES (new.id, new.name, new.keywords); END");
+    queries << QString(
+        "CREATE TRIGGER IF NOT EXISTS " % table %
+        "_fts_delete AFTER DELETE ON " % table % " BEGIN INSERT INTO " %
+        table % "_fts(" % table %
+        "_fts, rowid, name, keywords) "
+        "VALUES ('delete', old.id, old.name, old.keywords); END");
+  }
+
+  SQLiteDatabase::TransactionScopeGuard transactionGuard(*mDb);  // can throw
+  foreach (const QString& string, queries) {
+    QSqlQuery query = mDb->prepareQuery(string);  // can throw
+    mDb->exec(query);                             // can throw
+  }
+  transactionGuard.commit();  // can throw
+}
+
 void WorkspaceLibraryDb::getElementTranslations(const QString&     table,
                                                 const QString&     idRow,
                                                 const FilePath&    elemDir,
@@ -711,8 +823,10 @@ void WorkspaceLibraryDb::createAllTables() {
   queries << QString(
       "CREATE TABLE IF NOT EXISTS component_categories ("
       "`id` INTEGER PRIMARY KEY NOT NULL, "
-      "`lib_id` INTEGER NOT NULL, "
+      "`lib_id` INTEGER "
+      "REFERENCES libraries(id) ON DELETE CASCADE NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -733,8 +847,10 @@ void WorkspaceLibraryDb::createAllTables() {
   queries << QString(
       "CREATE TABLE IF NOT EXISTS package_categories ("
       "`id` INTEGER PRIMARY KEY NOT NULL, "
-      "`lib_id` INTEGER NOT NULL, "
+      "`lib_id` INTEGER "
+      "REFERENCES libraries(id) ON DELETE CASCADE NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -755,8 +871,10 @@ void WorkspaceLibraryDb::createAllTables() {
   queries << QString(
       "CREATE TABLE IF NOT EXISTS symbols ("
       "`id` INTEGER PRIMARY KEY NOT NULL, "
-      "`lib_id` INTEGER NOT NULL, "
+      "`lib_id` INTEGER "
+      "REFERENCES libraries(id) ON DELETE CASCADE NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -784,8 +902,10 @@ void WorkspaceLibraryDb::createAllTables() {
   queries << QString(
       "CREATE TABLE IF NOT EXISTS packages ("
       "`id` INTEGER PRIMARY KEY NOT NULL, "
-      "`lib_id` INTEGER NOT NULL, "
+      "`lib_id` INTEGER "
+      "REFERENCES libraries(id) ON DELETE CASCADE NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL "
       ")");
@@ -813,8 +933,10 @@ void WorkspaceLibraryDb::createAllTables() {
   queries << QString(
       "CREATE TABLE IF NOT EXISTS components ("
       "`id` INTEGER PRIMARY KEY NOT NULL, "
-      "`lib_id` INTEGER NOT NULL, "
+      "`lib_id` INTEGER "
+      "REFERENCES libraries(id) ON DELETE CASCADE NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -842,8 +964,10 @@ void WorkspaceLibraryDb::createAllTables() {
   queries << QString(
       "CREATE TABLE IF NOT EXISTS devices ("
       "`id` INTEGER PRIMARY KEY NOT NULL, "
-      "`lib_id` INTEGER NOT NULL, "
+      "`lib_id` INTEGER "
+      "REFERENCES libraries(id) ON DELETE CASCADE NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
@@ -869,6 +993,13 @@ void WorkspaceLibraryDb::createAllTables() {
       "UNIQUE(device_id, category_uuid)"
       ")");
 
+  // indices
+  queries << QString(
+      "CREATE INDEX IF NOT EXISTS components_uuid_index ON components(uuid)");
+  queries << QString(
+      "CREATE INDEX IF NOT EXISTS devices_component_uuid_index "
+      "ON devices(component_uuid)");
+
   // execute queries
   foreach (const QString& string, queries) {
     QSqlQuery query = mDb->prepareQuery(string);  // can throw
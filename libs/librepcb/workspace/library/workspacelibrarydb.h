@@ -118,7 +118,23 @@ public:
   QSet<Uuid>  getComponentsByCategory(const tl::optional<Uuid>& category) const;
   QSet<Uuid>  getDevicesByCategory(const tl::optional<Uuid>& category) const;
   QSet<Uuid>  getDevicesOfComponent(const Uuid& component) const;
-  QSet<Uuid>  getComponentsBySearchKeyword(const QString& keyword) const;
+
+  /**
+   * @brief Search components by their names or keywords (or those of their
+   *        devices)
+   *
+   * If SQLite supports FTS5, a full-text index is used: Every whitespace
+   * separated token of the keyword must match the beginning of a word and the
+   * results are ordered by relevance. Only if this finds no component at all,
+   * a (slow) substring search is done instead, so matches in the middle of a
+   * word (e.g. "555" in "NE555") are still found. Without FTS5, only the
+   * substring search is done, with unordered results.
+   *
+   * @param keyword   The search term entered by the user
+   *
+   * @return UUIDs of all matching components, best match first
+   */
+  QList<Uuid> getComponentsBySearchKeyword(const QString& keyword) const;
 
   // General Methods
 
@@ -141,6 +157,9 @@ signals:
 
 private:
   // Private Methods
+  QList<Uuid> getComponentsBySearchKeywordSlow(const QString& keyword) const;
+  bool        isFullTextSearchAvailable() const noexcept;
+  void        createFullTextSearchTables();
   void getElementTranslations(const QString& table, const QString& idRow,
                               const FilePath&    elemDir,
                               const QStringList& localeOrder, QString* name,
@@ -172,9 +191,10 @@ private:
   FilePath                       mFilePath;  ///< path to the SQLite database
   QScopedPointer<SQLiteDatabase> mDb;        ///< the SQLite database
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  bool mFullTextSearchAvailable;  ///< whether FTS5 tables exist
 
   // Constants
-  static const int sCurrentDbVersion = 2;
+  static const int sCurrentDbVersion = 4;
 };
 
 /*******************************************************************************
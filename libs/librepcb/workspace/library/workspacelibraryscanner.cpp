@@ -27,6 +27,7 @@
 #include <librepcb/common/sqlitedatabase.h>
 #include <librepcb/library/elements.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -47,7 +48,8 @@ WorkspaceLibraryScanner::WorkspaceLibraryScanner(
     mWorkspace(ws),
     mDbFilePath(dbFilePath),
     mSemaphore(0),
-    mAbort(false) {
+    mAbort(false),
+    mMaxParallelJobs(qMax(QThread::idealThreadCount(), 1)) {
   start();
 }
 
@@ -125,49 +127,47 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    clearAllTables(db);
-
-    // scan all libraries
-    int   count   = 0;
-    qreal percent = 0;
+    // determine the added and modified elements of all libraries (unchanged
+    // elements are not parsed again, see collectElementsToParse())
+    int               count = 0;
+    QList<ElementJob> jobs;
     foreach (const FilePath& fp, libraries.keys()) {
       Q_ASSERT(libIds.contains(fp));
       int                             libId = libIds[fp];
       const std::shared_ptr<Library>& lib   = libraries[fp];
       Q_ASSERT(lib);
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<ComponentCategory>(
+      if (isAborted()) break;
+      count += collectElementsToParse<ComponentCategory>(
           db, lib->searchForElements<ComponentCategory>(),
-          "component_categories", "cat_id", libId);
-      emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<PackageCategory>(
+          "component_categories", "cat_id", libId, jobs);  // can throw
+      count += collectElementsToParse<PackageCategory>(
           db, lib->searchForElements<PackageCategory>(), "package_categories",
-          "cat_id", libId);
-      emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Symbol>(db, lib->searchForElements<Symbol>(),
-                                       "symbols", "symbol_id", libId);
-      emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Package>(db, lib->searchForElements<Package>(),
-                                        "packages", "package_id", libId);
-      emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count +=
-          addElementsToDb<Component>(db, lib->searchForElements<Component>(),
-                                     "components", "component_id", libId);
-      emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addDevicesToDb(db, lib->searchForElements<Device>(), "devices",
-                              "device_id", libId);
-      emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
+          "cat_id", libId, jobs);  // can throw
+      count += collectElementsToParse<Symbol>(
+          db, lib->searchForElements<Symbol>(), "symbols", "symbol_id", libId,
+          jobs);  // can throw
+      count += collectElementsToParse<Package>(
+          db, lib->searchForElements<Package>(), "packages", "package_id",
+          libId, jobs);  // can throw
+      count += collectElementsToParse<Component>(
+          db, lib->searchForElements<Component>(), "components",
+          "component_id", libId, jobs);  // can throw
+      count += collectElementsToParse<Device>(
+          db, lib->searchForElements<Device>(), "devices", "device_id", libId,
+          jobs);  // can throw
+    }
+    qDebug() << "Workspace library elements to parse:" << jobs.count()
+             << "elements, determined in" << timer.elapsed() << "ms";
+
+    // parse all added and modified elements and add them to the database
+    if (!isAborted()) {
+      count += parseAndAddElements(db, jobs);
     }
 
     // commit transaction
-    if ((!mAbort) && (mSemaphore.available() == 0)) {
+    if (!isAborted()) {
       transactionGuard.commit();  // can throw
+      emit scanProgressUpdate(100);
       qDebug() << "Workspace library scan succeeded:" << count << "elements in"
                << timer.elapsed() << "ms";
       emit scanSucceeded(count);
@@ -290,208 +290,253 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
   return dbLibIds;
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db) {
-  // component categories
-  db.clearTable("component_categories_tr");
-  db.clearTable("component_categories");
-
-  // package categories
-  db.clearTable("package_categories_tr");
-  db.clearTable("package_categories");
-
-  // symbols
-  db.clearTable("symbols_tr");
-  db.clearTable("symbols_cat");
-  db.clearTable("symbols");
-
-  // packages
-  db.clearTable("packages_tr");
-  db.clearTable("packages_cat");
-  db.clearTable("packages");
-
-  // components
-  db.clearTable("components_tr");
-  db.clearTable("components_cat");
-  db.clearTable("components");
-
-  // devices
-  db.clearTable("devices_tr");
-  db.clearTable("devices_cat");
-  db.clearTable("devices");
+bool WorkspaceLibraryScanner::isAborted() const noexcept {
+  // a new scan request aborts the current scan too
+  return mAbort || (mSemaphore.available() > 0);
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addCategoriesToDb(SQLiteDatabase&        db,
-                                               const QList<FilePath>& dirs,
-                                               const QString&         table,
-                                               const QString&         idColumn,
-                                               int                    libId) {
-  int count = 0;
+int WorkspaceLibraryScanner::collectElementsToParse(
+    SQLiteDatabase& db, const QList<FilePath>& dirs, const QString& table,
+    const QString& idColumn, int libId, QList<ElementJob>& jobs) {
+  // get IDs and fingerprints of all elements of this library in the database
+  QHash<FilePath, QPair<int, QString>> dbElements;
+  QSqlQuery query = db.prepareQuery("SELECT id, filepath, fingerprint FROM " %
+                                    table % " WHERE lib_id = :lib_id");
+  query.bindValue(":lib_id", libId);
+  db.exec(query);
+  while (query.next()) {
+    FilePath fp(FilePath::fromRelative(mWorkspace.getLibrariesPath(),
+                                       query.value(1).toString()));
+    if (!fp.isValid()) throw LogicError(__FILE__, __LINE__);
+    dbElements.insert(fp, qMakePair(query.value(0).toInt(),
+                                    query.value(2).toString()));
+  }
+
+  // determine new and modified elements, remove modified elements from the
+  // database
+  int unchangedCount = 0;
   foreach (const FilePath& filepath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    try {
-      ElementType element(filepath, true);  // can throw
-      QSqlQuery   query = db.prepareQuery(
-          "INSERT INTO " % table %
-          " "
-          "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-          "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":parent_uuid", element.getParentUuid()
-                                          ? element.getParentUuid()->toStr()
-                                          : QVariant(QVariant::String));
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
+    if (isAborted()) return unchangedCount;
+    QString fingerprint = calcElementFingerprint(filepath);
+    auto    dbElement   = dbElements.find(filepath);
+    if (dbElement != dbElements.end()) {
+      int  id        = dbElement->first;
+      bool unchanged = (dbElement->second == fingerprint);
+      dbElements.erase(dbElement);
+      if (unchanged) {
+        unchangedCount++;
+        continue;  // no need to parse the element again
       }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
+      removeElementFromDb(db, table, id);  // can throw
     }
+    jobs.append(ElementJob{filepath, fingerprint, table, idColumn, libId,
+                           &parseElement<ElementType>});
   }
-  return count;
+
+  // remove elements which do no longer exist
+  foreach (const auto& dbElement, dbElements) {
+    removeElementFromDb(db, table, dbElement.first);  // can throw
+  }
+  return unchangedCount;
 }
 
-template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(SQLiteDatabase&        db,
-                                             const QList<FilePath>& dirs,
-                                             const QString&         table,
-                                             const QString&         idColumn,
-                                             int                    libId) {
-  int count = 0;
-  foreach (const FilePath& filepath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    try {
-      ElementType element(filepath, true);  // can throw
-      QSqlQuery   query =
-          db.prepareQuery("INSERT INTO " % table %
-                          " "
-                          "(lib_id, filepath, uuid, version) VALUES "
-                          "(:lib_id, :filepath, :uuid, :version)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
+int WorkspaceLibraryScanner::parseAndAddElements(
+    SQLiteDatabase& db, const QList<ElementJob>& jobs) noexcept {
+  // All elements of all libraries are parsed concurrently in the thread pool,
+  // but only this thread writes them into the database since the database
+  // connection must not be shared between threads. The results are consumed
+  // in the order of the jobs, so the database content does not depend on the
+  // number of threads. The number of pending jobs is limited to keep the
+  // memory usage bounded.
+  std::shared_ptr<QAtomicInt>  cancelled = std::make_shared<QAtomicInt>(0);
+  const int                    maxPendingJobs = mMaxParallelJobs * 4;
+  QQueue<QFuture<ElementData>> pendingJobs;
+  int                          nextIndex   = 0;
+  int                          count       = 0;
+  int                          lastPercent = 0;
+  for (int i = 0; i < jobs.count(); ++i) {
+    while ((nextIndex < jobs.count()) &&
+           (pendingJobs.count() < maxPendingJobs)) {
+      const ElementJob& job = jobs.at(nextIndex++);
+      ElementParser     parser      = job.parser;
+      FilePath          filepath    = job.filepath;
+      QString           fingerprint = job.fingerprint;
+      pendingJobs.enqueue(QtConcurrent::run(
+          [parser, filepath, fingerprint, cancelled]() -> ElementData {
+            if (cancelled->loadAcquire()) {
+              return ElementData();  // scan aborted, skip parsing
+            }
+            return parser(filepath, fingerprint);
+          }));
+    }
+    ElementData data = pendingJobs.dequeue().result();  // blocks until parsed
+    if (isAborted()) {
+      // Let all queued jobs return immediately and wait for them, so no job
+      // is running anymore when the scan has finished.
+      cancelled->storeRelease(1);
+      while (!pendingJobs.isEmpty()) {
+        pendingJobs.dequeue().waitForFinished();
       }
-      foreach (const Uuid& categoryUuid, element.getCategories()) {
-        QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                          "_cat "
-                                          "(" %
-                                          idColumn %
-                                          ", category_uuid) VALUES "
-                                          "(:element_id, :category_uuid)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":category_uuid", categoryUuid.toStr());
-        db.insert(query);
+      return count;
+    }
+    const ElementJob& job = jobs.at(i);
+    if (data.columns.isEmpty()) {
+      qWarning() << "Failed to open library element:"
+                 << job.filepath.toNative();
+    } else {
+      try {
+        addElementToDb(db, data, job.table, job.idColumn,
+                       job.libId);  // can throw
+        count++;
+      } catch (const Exception& e) {
+        qWarning() << "Failed to add library element to database:"
+                   << job.filepath.toNative();
       }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
+    }
+    int percent = ((i + 1) * 100) / jobs.count();
+    if (percent != lastPercent) {
+      lastPercent = percent;
+      emit scanProgressUpdate(percent);
     }
   }
   return count;
 }
 
-int WorkspaceLibraryScanner::addDevicesToDb(SQLiteDatabase&        db,
-                                            const QList<FilePath>& dirs,
-                                            const QString&         table,
-                                            const QString&         idColumn,
-                                            int                    libId) {
-  int count = 0;
-  foreach (const FilePath& filepath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    try {
-      Device    element(filepath, true);  // can throw
-      QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                        " "
-                                        "(lib_id, filepath, uuid, version, "
-                                        "component_uuid, package_uuid) VALUES "
-                                        "(:lib_id, :filepath, :uuid, :version, "
-                                        ":component_uuid, :package_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":component_uuid", element.getComponentUuid().toStr());
-      query.bindValue(":package_uuid", element.getPackageUuid().toStr());
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
-      }
-      foreach (const Uuid& categoryUuid, element.getCategories()) {
-        QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                          "_cat "
-                                          "(" %
-                                          idColumn %
-                                          ", category_uuid) VALUES "
-                                          "(:element_id, :category_uuid)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":category_uuid", categoryUuid.toStr());
-        db.insert(query);
-      }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
+template <typename ElementType>
+WorkspaceLibraryScanner::ElementData WorkspaceLibraryScanner::parseElement(
+    const FilePath& filepath, const QString& fingerprint) noexcept {
+  // Attention: This method is executed in a thread pool, do not access any
+  // members of the scanner here!
+  ElementData data;
+  data.filepath    = filepath;
+  data.fingerprint = fingerprint;
+  try {
+    ElementType element(filepath, true);  // can throw
+    fillElementData(data, element);
+    foreach (const QString& locale, element.getAllAvailableLocales()) {
+      ElementData::Translation tr;
+      tr.locale = locale;
+      tr.name   = optionalToVariant(element.getNames().tryGet(locale));
+      tr.description =
+          optionalToVariant(element.getDescriptions().tryGet(locale));
+      tr.keywords = optionalToVariant(element.getKeywords().tryGet(locale));
+      data.translations.append(tr);
     }
+  } catch (const Exception& e) {
+    data.columns.clear();  // mark as invalid
   }
-  return count;
+  return data;
+}
+
+void WorkspaceLibraryScanner::fillElementData(
+    ElementData& data, const LibraryCategory& element) noexcept {
+  data.columns.insert("uuid", element.getUuid().toStr());
+  data.columns.insert("version", element.getVersion().toStr());
+  data.columns.insert("parent_uuid", element.getParentUuid()
+                                         ? element.getParentUuid()->toStr()
+                                         : QVariant(QVariant::String));
+}
+
+void WorkspaceLibraryScanner::fillElementData(
+    ElementData& data, const LibraryElement& element) noexcept {
+  data.columns.insert("uuid", element.getUuid().toStr());
+  data.columns.insert("version", element.getVersion().toStr());
+  foreach (const Uuid& categoryUuid, element.getCategories()) {
+    data.categories.append(categoryUuid.toStr());
+  }
+}
+
+void WorkspaceLibraryScanner::fillElementData(ElementData&  data,
+                                              const Device& element) noexcept {
+  fillElementData(data, static_cast<const LibraryElement&>(element));
+  data.columns.insert("component_uuid", element.getComponentUuid().toStr());
+  data.columns.insert("package_uuid", element.getPackageUuid().toStr());
+}
+
+void WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase&    db,
+                                             const ElementData& data,
+                                             const QString&     table,
+                                             const QString&     idColumn,
+                                             int                libId) {
+  QStringList columns = {"lib_id", "filepath", "fingerprint"};
+  columns += data.columns.keys();
+  QSqlQuery query = db.prepareQuery("INSERT INTO " % table % " (" %
+                                    columns.join(", ") % ") VALUES (:" %
+                                    columns.join(", :") % ")");
+  query.bindValue(":lib_id", libId);
+  query.bindValue(":filepath",
+                  data.filepath.toRelative(mWorkspace.getLibrariesPath()));
+  query.bindValue(":fingerprint", data.fingerprint);
+  for (auto it = data.columns.constBegin(); it != data.columns.constEnd();
+       ++it) {
+    query.bindValue(":" % it.key(), it.value());
+  }
+  int id = db.insert(query);
+
+  foreach (const ElementData::Translation& tr, data.translations) {
+    QSqlQuery query = db.prepareQuery(
+        "INSERT INTO " % table %
+        "_tr "
+        "(" %
+        idColumn %
+        ", locale, name, description, keywords) VALUES "
+        "(:element_id, :locale, :name, :description, :keywords)");
+    query.bindValue(":element_id", id);
+    query.bindValue(":locale", tr.locale);
+    query.bindValue(":name", tr.name);
+    query.bindValue(":description", tr.description);
+    query.bindValue(":keywords", tr.keywords);
+    db.insert(query);
+  }
+
+  foreach (const QString& categoryUuid, data.categories) {
+    QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
+                                      "_cat "
+                                      "(" %
+                                      idColumn %
+                                      ", category_uuid) VALUES "
+                                      "(:element_id, :category_uuid)");
+    query.bindValue(":element_id", id);
+    query.bindValue(":category_uuid", categoryUuid);
+    db.insert(query);
+  }
+}
+
+void WorkspaceLibraryScanner::removeElementFromDb(SQLiteDatabase& db,
+                                                  const QString&  table,
+                                                  int             id) {
+  // Note: Translations and categories are removed by "ON DELETE CASCADE".
+  QSqlQuery query = db.prepareQuery("DELETE FROM " % table % " WHERE id = :id");
+  query.bindValue(":id", id);
+  db.exec(query);
+}
+
+QString WorkspaceLibraryScanner::calcElementFingerprint(
+    const FilePath& dir) noexcept {
+  // The fingerprint is built from names, sizes and modification dates of all
+  // files within the element directory. This is much faster than parsing the
+  // element (or hashing its content) and detects all relevant modifications
+  // like editing, replacing or adding files.
+  QString      dirPath = dir.toStr();
+  QStringList  entries;
+  QDirIterator it(dirPath, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    QFileInfo info = it.fileInfo();
+    entries.append(QString("%1:%2:%3")
+                       .arg(info.absoluteFilePath().mid(dirPath.length()))
+                       .arg(info.size())
+                       .arg(info.lastModified().toMSecsSinceEpoch()));
+  }
+  entries.sort();  // make the fingerprint independent of the iteration order
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  foreach (const QString& entry, entries) {
+    hash.addData(entry.toUtf8());
+    hash.addData("\n", 1);
+  }
+  return QString(hash.result().toHex());
 }
 
 /*******************************************************************************
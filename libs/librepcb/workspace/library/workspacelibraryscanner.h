@@ -39,6 +39,9 @@ class SQLiteDatabase;
 
 namespace library {
 class Library;
+class LibraryCategory;
+class LibraryElement;
+class Device;
 }
 
 namespace workspace {
@@ -80,25 +83,66 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  /// All the data of a parsed library element to be added to the database
+  struct ElementData {
+    struct Translation {
+      QString  locale;
+      QVariant name;
+      QVariant description;
+      QVariant keywords;
+    };
+    FilePath                filepath;
+    QString                 fingerprint;
+    QMap<QString, QVariant> columns;  ///< empty if the element is invalid
+    QList<Translation>      translations;
+    QStringList             categories;
+  };
+
+  /// Parses the library element in the passed directory
+  typedef ElementData (*ElementParser)(const FilePath& filepath,
+                                       const QString&  fingerprint);
+
+  /// A library element which needs to be parsed and added to the database
+  struct ElementJob {
+    FilePath      filepath;
+    QString       fingerprint;
+    QString       table;
+    QString       idColumn;
+    int           libId;
+    ElementParser parser;
+  };
+
 private:  // Methods
   void                 run() noexcept override;
   void                 scan() noexcept;
   QHash<FilePath, int> updateLibraries(
       SQLiteDatabase&                                           db,
       const QHash<FilePath, std::shared_ptr<library::Library>>& libs);
-  void clearAllTables(SQLiteDatabase& db);
   void getLibrariesOfDirectory(
       const FilePath&                                     dir,
       QHash<FilePath, std::shared_ptr<library::Library>>& libs) noexcept;
+  bool isAborted() const noexcept;
   template <typename ElementType>
-  int addCategoriesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                        const QString& table, const QString& idColumn,
-                        int libId);
+  int collectElementsToParse(SQLiteDatabase& db, const QList<FilePath>& dirs,
+                             const QString& table, const QString& idColumn,
+                             int libId, QList<ElementJob>& jobs);
+  int parseAndAddElements(SQLiteDatabase&          db,
+                          const QList<ElementJob>& jobs) noexcept;
   template <typename ElementType>
-  int addElementsToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                      const QString& table, const QString& idColumn, int libId);
-  int addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                     const QString& table, const QString& idColumn, int libId);
+  static ElementData parseElement(const FilePath& filepath,
+                                  const QString&  fingerprint) noexcept;
+  static void fillElementData(ElementData&                    data,
+                              const library::LibraryCategory& element) noexcept;
+  static void fillElementData(ElementData&                   data,
+                              const library::LibraryElement& element) noexcept;
+  static void fillElementData(ElementData&           data,
+                              const library::Device& element) noexcept;
+  void addElementToDb(SQLiteDatabase& db, const ElementData& data,
+                      const QString& table, const QString& idColumn,
+                      int libId);
+  void removeElementFromDb(SQLiteDatabase& db, const QString& table, int id);
+  static QString calcElementFingerprint(const FilePath& dir) noexcept;
   template <typename T>
   static QVariant optionalToVariant(const T& opt) noexcept;
 
@@ -107,6 +151,7 @@ private:  // Data
   FilePath      mDbFilePath;
   QSemaphore    mSemaphore;
   volatile bool mAbort;
+  int           mMaxParallelJobs;  ///< number of elements parsed concurrently
 };
 
 /*******************************************************************************
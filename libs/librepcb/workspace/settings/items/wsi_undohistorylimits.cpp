@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "wsi_undohistorylimits.h"
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+WSI_UndoHistoryLimits::WSI_UndoHistoryLimits(const SExpression& node)
+  : WSI_Base(),
+    mMaxSteps(0),
+    mMaxStepsTmp(mMaxSteps),
+    mMaxMemoryMb(256),
+    mMaxMemoryMbTmp(mMaxMemoryMb) {
+  if (const SExpression* child =
+          node.tryGetChildByPath("undo_history_max_steps")) {
+    mMaxSteps = child->getValueOfFirstChild<uint>();
+  }
+  if (const SExpression* child =
+          node.tryGetChildByPath("undo_history_max_memory")) {
+    mMaxMemoryMb = child->getValueOfFirstChild<uint>();
+  }
+  mMaxStepsTmp    = mMaxSteps;
+  mMaxMemoryMbTmp = mMaxMemoryMb;
+
+  // create the spinboxes
+  mStepsSpinBox.reset(new QSpinBox());
+  mStepsSpinBox->setMinimum(0);
+  mStepsSpinBox->setMaximum(100000);
+  mStepsSpinBox->setSpecialValueText(tr("Unlimited"));
+  mStepsSpinBox->setSuffix(tr(" Steps"));
+  mStepsSpinBox->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+  connect(mStepsSpinBox.data(),
+          static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
+          [this](int value) { mMaxStepsTmp = value; });
+  mMemorySpinBox.reset(new QSpinBox());
+  mMemorySpinBox->setMinimum(0);
+  mMemorySpinBox->setMaximum(65536);
+  mMemorySpinBox->setSpecialValueText(tr("Unlimited"));
+  mMemorySpinBox->setSuffix(tr(" MB"));
+  mMemorySpinBox->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+  connect(mMemorySpinBox.data(),
+          static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
+          [this](int value) { mMaxMemoryMbTmp = value; });
+  updateWidgets();
+
+  // create a QWidget
+  mWidget.reset(new QWidget());
+  QHBoxLayout* layout = new QHBoxLayout(mWidget.data());
+  layout->setContentsMargins(0, 0, 0, 0);
+  layout->addWidget(mStepsSpinBox.data());
+  layout->addWidget(mMemorySpinBox.data());
+  layout->addWidget(new QLabel(tr("(applies to newly opened projects)")));
+}
+
+WSI_UndoHistoryLimits::~WSI_UndoHistoryLimits() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void WSI_UndoHistoryLimits::restoreDefault() noexcept {
+  mMaxStepsTmp    = 0;
+  mMaxMemoryMbTmp = 256;
+  updateWidgets();
+}
+
+void WSI_UndoHistoryLimits::apply() noexcept {
+  mMaxSteps    = mMaxStepsTmp;
+  mMaxMemoryMb = mMaxMemoryMbTmp;
+}
+
+void WSI_UndoHistoryLimits::revert() noexcept {
+  mMaxStepsTmp    = mMaxSteps;
+  mMaxMemoryMbTmp = mMaxMemoryMb;
+  updateWidgets();
+}
+
+void WSI_UndoHistoryLimits::serialize(SExpression& root) const {
+  root.appendChild("undo_history_max_steps", mMaxSteps, true);
+  root.appendChild("undo_history_max_memory", mMaxMemoryMb, true);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void WSI_UndoHistoryLimits::updateWidgets() noexcept {
+  mStepsSpinBox->setValue(mMaxStepsTmp);
+  mMemorySpinBox->setValue(mMaxMemoryMbTmp);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WSI_UNDOHISTORYLIMITS_H
+#define LIBREPCB_WSI_UNDOHISTORYLIMITS_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "wsi_base.h"
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*******************************************************************************
+ *  Class WSI_UndoHistoryLimits
+ ******************************************************************************/
+
+/**
+ * @brief The WSI_UndoHistoryLimits class represents the limits of the undo
+ * history of projects
+ *
+ * These settings are passed to the librepcb::UndoStack of opened projects. If
+ * the undo history exceeds one of the limits, its oldest steps are discarded.
+ * A value of zero means that the corresponding limit is disabled.
+ */
+class WSI_UndoHistoryLimits final : public WSI_Base {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  WSI_UndoHistoryLimits()                                   = delete;
+  WSI_UndoHistoryLimits(const WSI_UndoHistoryLimits& other) = delete;
+  explicit WSI_UndoHistoryLimits(const SExpression& node);
+  ~WSI_UndoHistoryLimits() noexcept;
+
+  // Getters
+  uint   getMaxSteps() const noexcept { return mMaxSteps; }
+  uint   getMaxMemoryMb() const noexcept { return mMaxMemoryMb; }
+  qint64 getMaxMemoryBytes() const noexcept {
+    return qint64(mMaxMemoryMb) * 1024 * 1024;
+  }
+
+  // Getters: Widgets
+  QString  getLabelText() const noexcept { return tr("Undo History Limits:"); }
+  QWidget* getWidget() const noexcept { return mWidget.data(); }
+
+  // General Methods
+  void restoreDefault() noexcept override;
+  void apply() noexcept override;
+  void revert() noexcept override;
+
+  /// @copydoc librepcb::SerializableObject::serialize()
+  void serialize(SExpression& root) const override;
+
+  // Operator Overloadings
+  WSI_UndoHistoryLimits& operator=(const WSI_UndoHistoryLimits& rhs) = delete;
+
+private:  // Methods
+  void updateWidgets() noexcept;
+
+private:  // Data
+  // General Attributes
+
+  /**
+   * @brief Maximum count of undo steps (0 = unlimited)
+   *
+   * Default: 0
+   */
+  uint mMaxSteps;
+  uint mMaxStepsTmp;
+
+  /**
+   * @brief Maximum estimated memory usage [MB] (0 = unlimited)
+   *
+   * Default: 256
+   */
+  uint mMaxMemoryMb;
+  uint mMaxMemoryMbTmp;
+
+  // Widgets
+  QScopedPointer<QWidget>  mWidget;
+  QScopedPointer<QSpinBox> mStepsSpinBox;
+  QScopedPointer<QSpinBox> mMemorySpinBox;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
+
+#endif  // LIBREPCB_WSI_UNDOHISTORYLIMITS_H
@@ -60,6 +60,7 @@ WorkspaceSettings::WorkspaceSettings(const Workspace& workspace)
   loadSettingsItem(mAppLocale, root);
   loadSettingsItem(mAppDefMeasUnits, root);
   loadSettingsItem(mProjectAutosaveInterval, root);
+  loadSettingsItem(mUndoHistoryLimits, root);
   loadSettingsItem(mAppearance, root);
   loadSettingsItem(mLibraryLocaleOrder, root);
   loadSettingsItem(mLibraryNormOrder, root);
@@ -56,6 +56,8 @@ WorkspaceSettingsDialog::WorkspaceSettingsDialog(WorkspaceSettings& settings)
   mUi->generalLayout->addRow(
       mSettings.getProjectAutosaveInterval().getLabelText(),
       mSettings.getProjectAutosaveInterval().getWidget());
+  mUi->generalLayout->addRow(mSettings.getUndoHistoryLimits().getLabelText(),
+                             mSettings.getUndoHistoryLimits().getWidget());
 
   // tab: appearance
   mUi->appearanceLayout->addRow(
@@ -101,6 +103,7 @@ WorkspaceSettingsDialog::~WorkspaceSettingsDialog() {
   mSettings.getAppLocale().getWidget()->setParent(0);
   mSettings.getAppDefMeasUnits().getLengthUnitComboBox()->setParent(0);
   mSettings.getProjectAutosaveInterval().getWidget()->setParent(0);
+  mSettings.getUndoHistoryLimits().getWidget()->setParent(0);
 
   // tab: appearance
   mSettings.getAppearance().getUseOpenGlWidget()->setParent(0);
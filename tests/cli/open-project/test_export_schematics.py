@@ -61,3 +61,48 @@ def test_if_output_directories_are_created(cli):
     assert stdout[-1] == 'SUCCESS'
     assert os.path.exists(dir)
     assert os.path.exists(path)
+
+
+def test_skipping_unchanged_schematics(cli):
+    path = cli.abspath('sch.pdf')
+    fingerprints = path + '.fingerprints'
+    assert not os.path.exists(path)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-schematics=sch.pdf',
+                                   '--skip-unchanged-schematics',
+                                   PROJECT_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    assert os.path.exists(path)
+    assert os.path.exists(fingerprints)
+
+    # export again without any changes -> file must not be written again
+    os.remove(path)
+    with open(path, 'w') as f:
+        f.write('marker')
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-schematics=sch.pdf',
+                                   '--skip-unchanged-schematics',
+                                   PROJECT_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert 'No page has changed' in stdout[-2]
+    assert stdout[-1] == 'SUCCESS'
+    with open(path) as f:
+        assert f.read() == 'marker'
+
+    # pretend a page has changed -> the whole file must be written again
+    with open(fingerprints, 'w') as f:
+        f.write('(librepcb_schematic_fingerprints)\n')
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-schematics=sch.pdf',
+                                   '--skip-unchanged-schematics',
+                                   PROJECT_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    with open(path, 'rb') as f:
+        assert f.read().startswith(b'%PDF')
+    with open(fingerprints) as f:
+        assert '(page ' in f.read()
@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/drillpathoptimizer.h>
+
+#include <QtCore>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class DrillPathOptimizerTest : public ::testing::Test {
+protected:
+  static QVector<Point> createRandomHits(int count) {
+    std::mt19937                          generator(42);
+    std::uniform_int_distribution<qint32> x(0, 100000000);  // 100mm
+    std::uniform_int_distribution<qint32> y(0, 80000000);   // 80mm
+    QVector<Point>                        hits;
+    for (int i = 0; i < count; ++i) {
+      hits.append(Point(x(generator), y(generator)));
+    }
+    return hits;
+  }
+
+  static QList<QPair<LengthBase_t, LengthBase_t>> sorted(
+      const QVector<Point>& points) {
+    QList<QPair<LengthBase_t, LengthBase_t>> list;
+    foreach (const Point& p, points) {
+      list.append(qMakePair(p.getX().toNm(), p.getY().toNm()));
+    }
+    std::sort(list.begin(), list.end());
+    return list;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(DrillPathOptimizerTest, testTrivialInputs) {
+  EXPECT_EQ(QVector<Point>(),
+            DrillPathOptimizer::optimize(QVector<Point>(), Point(0, 0)));
+  QVector<Point> single = {Point(5, 5)};
+  EXPECT_EQ(single, DrillPathOptimizer::optimize(single, Point(0, 0)));
+}
+
+TEST_F(DrillPathOptimizerTest, testHitsOnLine) {
+  QVector<Point> hits = {Point(3000, 0), Point(1000, 0), Point(4000, 0),
+                         Point(2000, 0), Point(1000, 0)};
+  QVector<Point> expected = {Point(1000, 0), Point(1000, 0), Point(2000, 0),
+                             Point(3000, 0), Point(4000, 0)};
+  EXPECT_EQ(expected, DrillPathOptimizer::optimize(hits, Point(0, 0)));
+  EXPECT_EQ(4000, DrillPathOptimizer::calcTravelDistance(expected, Point()));
+}
+
+/**
+ * Benchmark of the drill path optimization with random hits, reporting the
+ * total travel distance before and after the optimization.
+ */
+TEST_F(DrillPathOptimizerTest, testRandomHitsBenchmark) {
+  foreach (int count, QList<int>({100, 1000, 10000})) {
+    QVector<Point> hits = createRandomHits(count);
+    QElapsedTimer  timer;
+    timer.start();
+    QVector<Point> optimized = DrillPathOptimizer::optimize(hits, Point());
+    qint64         ms        = timer.elapsed();
+    EXPECT_EQ(sorted(hits), sorted(optimized));
+
+    qreal before = DrillPathOptimizer::calcTravelDistance(hits, Point());
+    qreal after  = DrillPathOptimizer::calcTravelDistance(optimized, Point());
+    EXPECT_LT(after, before / 5);
+    std::cout << "[          ] " << count << " hits: travel distance "
+              << qRound64(before / 1000000) << " mm before, "
+              << qRound64(after / 1000000) << " mm after (" << ms << " ms)"
+              << std::endl;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
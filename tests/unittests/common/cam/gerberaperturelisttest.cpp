@@ -0,0 +1,101 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerberaperturelist.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GerberApertureListTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST(GerberApertureListTest, testSameApertureIsReused) {
+  GerberApertureList list;
+  UnsignedLength     one(1000000);
+  UnsignedLength     two(2000000);
+  UnsignedLength     none(0);
+  EXPECT_EQ(10, list.setCircle(one, none));
+  EXPECT_EQ(11, list.setCircle(two, none));
+  EXPECT_EQ(12, list.setRect(one, two, Angle::deg0(), none));
+  EXPECT_EQ(12, list.setRect(one, two, Angle::deg180(), none));
+  EXPECT_EQ(13, list.setRect(one, two, Angle::deg90(), none));
+  EXPECT_EQ(13, list.setRect(two, one, Angle::deg0(), none));
+  EXPECT_EQ(14, list.setRect(one, two, Angle::deg45(), none));
+  EXPECT_EQ(15, list.setObround(one, two, Angle::deg45(), one));
+  EXPECT_EQ(16, list.setRegularPolygon(two, 6, Angle::deg0(), none));
+  EXPECT_EQ(10, list.setCircle(one, none));
+  EXPECT_EQ(14, list.setRect(one, two, Angle::deg45(), none));
+  EXPECT_EQ(16, list.setRegularPolygon(two, 6, Angle::deg0(), none));
+}
+
+TEST(GerberApertureListTest, testEquivalentRotationsAreReused) {
+  GerberApertureList list;
+  UnsignedLength     one(1000000);
+  UnsignedLength     two(2000000);
+  UnsignedLength     none(0);
+  EXPECT_EQ(10, list.setRect(one, two, Angle::deg45(), none));
+  EXPECT_EQ(10, list.setRect(one, two, Angle(405000000), none));
+  EXPECT_EQ(10, list.setRect(one, two, -Angle::deg315(), none));
+  EXPECT_EQ(11, list.setObround(one, two, -Angle::deg45(), none));
+  EXPECT_EQ(11, list.setObround(one, two, Angle::deg315(), none));
+}
+
+TEST(GerberApertureListTest, testGenerateString) {
+  GerberApertureList list;
+  list.setCircle(UnsignedLength(1000000), UnsignedLength(0));
+  list.setRect(UnsignedLength(1000000), UnsignedLength(2000000),
+               Angle::deg90(), UnsignedLength(500000));
+  list.setRect(UnsignedLength(1000000), UnsignedLength(2000000),
+               Angle::deg45(), UnsignedLength(0));
+  QString expected =
+      "G04 --- APERTURE LIST BEGIN --- *\n"
+      "%AMROTATEDRECT*21,1,$1,$2,0,0,$3*%\n"
+      "%ADD10C,1.0*%\n"
+      "%ADD11R,2.0X1.0X0.5*%\n"
+      "%ADD12ROTATEDRECT,1.0X2.0X45.0*%\n"
+      "G04 --- APERTURE LIST END --- *\n";
+  EXPECT_EQ(expected.toStdString(), list.generateString().toStdString());
+
+  list.reset();
+  list.setCircle(UnsignedLength(2000000), UnsignedLength(0));
+  EXPECT_TRUE(list.generateString().contains("%ADD10C,2.0*%\n"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,83 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GerberGeneratorTest : public ::testing::TestWithParam<int> {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_P(GerberGeneratorTest, testGenerate) {
+  GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+  for (int i = 0; i < GetParam(); ++i) {
+    gen.drawLine(Point(i, 0), Point(i, 1000), UnsignedLength(100 + (i % 3)));
+  }
+
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  gen.generate(buffer);
+  QByteArray output = buffer.data();
+
+  // apertures must be defined before the content
+  int apertureListEnd = output.indexOf("G04 --- APERTURE LIST END --- *\n");
+  int boardBegin      = output.indexOf("G04 --- BOARD BEGIN --- *\n");
+  int boardEnd        = output.indexOf("G04 --- BOARD END --- *\n");
+  EXPECT_GT(apertureListEnd, 0);
+  EXPECT_GT(boardBegin, apertureListEnd);
+  EXPECT_GT(boardEnd, boardBegin);
+  EXPECT_EQ(3, output.count("%ADD"));
+  EXPECT_EQ(GetParam(), output.count("D01*\n"));
+  EXPECT_TRUE(output.endsWith("M02*\n"));
+
+  // the checksum covers everything before it, excluding linebreaks
+  int        md5Pos   = output.indexOf("%TF.MD5,");
+  QByteArray data     = output.left(md5Pos).replace('\n', QByteArray());
+  QByteArray checksum = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+  EXPECT_EQ("%TF.MD5," + checksum.toHex() + "*%\n",
+            output.mid(md5Pos, output.indexOf('\n', md5Pos) - md5Pos + 1));
+}
+
+// small content is kept in memory, large content is spooled to a temp file
+INSTANTIATE_TEST_CASE_P(GerberGeneratorTest, GerberGeneratorTest,
+                        ::testing::Values(3, 100000));
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/asyncsexprfilewriter.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class AsyncSExprFileWriterTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+
+  AsyncSExprFileWriterTest() { mTempDir = FilePath::getRandomTempPath(); }
+
+  virtual ~AsyncSExprFileWriterTest() {
+    QDir(mTempDir.toStr()).removeRecursively();
+  }
+
+  static QStringList startAndWait(AsyncSExprFileWriter& writer) {
+    QStringList             errors;
+    QEventLoop              loop;
+    QMetaObject::Connection connection = QObject::connect(
+        &writer, &AsyncSExprFileWriter::finished, [&](const QStringList& e) {
+          errors = e;
+          loop.quit();
+        });
+    writer.start();
+    loop.exec();
+    QObject::disconnect(connection);
+    return errors;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(AsyncSExprFileWriterTest, testWriteFiles) {
+  AsyncSExprFileWriter writer;
+  QList<int>           progress;
+  QObject::connect(&writer, &AsyncSExprFileWriter::progressChanged,
+                   [&](int percent) { progress.append(percent); });
+
+  QHash<FilePath, QByteArray> expected;
+  for (int i = 0; i < 20; ++i) {
+    FilePath    fp  = mTempDir.getPathTo(QString("dir%1/file.lp").arg(i));
+    SExpression doc = SExpression::createList("root");
+    doc.appendChild("index", i, true);
+    expected.insert(fp, doc.toByteArray());
+    writer.addFile(fp, std::move(doc));
+  }
+  EXPECT_EQ(QStringList(), startAndWait(writer));
+  EXPECT_FALSE(writer.isRunning());
+  ASSERT_FALSE(progress.isEmpty());
+  EXPECT_EQ(100, progress.last());
+  foreach (const FilePath& fp, expected.keys()) {
+    EXPECT_EQ(expected.value(fp), FileUtils::readFile(fp))
+        << qPrintable(fp.toStr());
+  }
+}
+
+TEST_F(AsyncSExprFileWriterTest, testReportErrors) {
+  FilePath blocker = mTempDir.getPathTo("file");
+  FileUtils::writeFile(blocker, "foo");
+
+  AsyncSExprFileWriter writer;
+  writer.addFile(blocker.getPathTo("a.lp"), SExpression::createList("root"));
+  writer.addFile(mTempDir.getPathTo("b.lp"), SExpression::createList("root"));
+  EXPECT_EQ(1, startAndWait(writer).count());
+  EXPECT_TRUE(mTempDir.getPathTo("b.lp").isExistingFile());
+}
+
+TEST_F(AsyncSExprFileWriterTest, testWriterIsReusable) {
+  AsyncSExprFileWriter writer;
+  EXPECT_EQ(QStringList(), startAndWait(writer));  // nothing to write
+  writer.addFile(mTempDir.getPathTo("a.lp"), SExpression::createList("root"));
+  EXPECT_EQ(QStringList(), startAndWait(writer));
+  EXPECT_TRUE(mTempDir.getPathTo("a.lp").isExistingFile());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
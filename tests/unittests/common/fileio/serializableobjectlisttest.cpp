@@ -160,6 +160,52 @@ TEST_F(SerializableObjectListTest, testIndexOfName) {
   EXPECT_EQ(2, l.indexOf(mMocks[2]->mName));
 }
 
+TEST_F(SerializableObjectListTest, testIndexOfUuidAfterModifications) {
+  List l;
+  l.append(mMocks[0]);
+  l.insert(0, mMocks[1]);  // shifts the indices of the other elements
+  l.append(mMocks[2]);
+  EXPECT_EQ(1, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(0, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(2, l.indexOf(mMocks[2]->mUuid));
+  l.swap(0, 2);
+  EXPECT_EQ(1, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(2, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(0, l.indexOf(mMocks[2]->mUuid));
+  l.remove(0);
+  EXPECT_EQ(0, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(-1, l.indexOf(mMocks[2]->mUuid));
+  l.remove(1);
+  EXPECT_EQ(0, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(-1, l.indexOf(mMocks[1]->mUuid));
+  List moved(std::move(l));
+  EXPECT_EQ(0, moved.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(-1, l.indexOf(mMocks[0]->mUuid));
+}
+
+TEST_F(SerializableObjectListTest, testIndexOfDuplicateUuid) {
+  std::shared_ptr<Mock> duplicate = std::make_shared<Mock>(*mMocks[0]);
+  List                  l{mMocks[1], mMocks[0], duplicate};
+  EXPECT_EQ(1, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(mMocks[0], l.find(mMocks[0]->mUuid));
+  l.remove(2);
+  EXPECT_EQ(1, l.indexOf(mMocks[0]->mUuid));
+  l.append(duplicate);
+  l.remove(1);
+  EXPECT_EQ(duplicate, l.find(mMocks[0]->mUuid));
+}
+
+TEST_F(SerializableObjectListTest, testSortedByUuid) {
+  List l{mMocks[0], mMocks[1], mMocks[2]};
+  List sorted = l.sortedByUuid();
+  EXPECT_EQ(mMocks[2], sorted[0]);
+  EXPECT_EQ(mMocks[1], sorted[1]);
+  EXPECT_EQ(mMocks[0], sorted[2]);
+  EXPECT_EQ(0, sorted.indexOf(mMocks[2]->mUuid));
+  EXPECT_EQ(2, sorted.indexOf(mMocks[0]->mUuid));
+}
+
 TEST_F(SerializableObjectListTest, testContainsPointer) {
   List l{mMocks[0], mMocks[1], mMocks[2]};
   EXPECT_TRUE(l.contains(mMocks[0].get()));
@@ -0,0 +1,242 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexpression.h>
+
+#include <QtCore>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SExpressionTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST(SExpressionTest, testParseTokensAndStrings) {
+  QByteArray  content = "(root 42 \"foo bar\"\n (child none)\n)\n";
+  SExpression s       = SExpression::parse(content, FilePath());
+  EXPECT_TRUE(s.isList());
+  EXPECT_EQ("root", s.getName());
+  EXPECT_EQ(3, s.getChildren().count());
+  EXPECT_TRUE(s.getChildByIndex(0).isToken());
+  EXPECT_EQ(42, s.getChildByIndex(0).getValue<int>());
+  EXPECT_TRUE(s.getChildByIndex(1).isString());
+  EXPECT_EQ("foo bar", s.getChildByIndex(1).getValue<QString>());
+  EXPECT_EQ("none", s.getValueByPath<QString>("child"));
+}
+
+TEST(SExpressionTest, testParseRecordsLineAndColumn) {
+  QByteArray  content = "(root\n  (child \"\xC3\xA4\" x)\n)";
+  SExpression s       = SExpression::parse(content, FilePath());
+  EXPECT_EQ(1, s.getFileLine());
+  EXPECT_EQ(1, s.getFileColumn());
+  const SExpression& child = s.getChildByPath("child");
+  EXPECT_EQ(2, child.getFileLine());
+  EXPECT_EQ(3, child.getFileColumn());
+  EXPECT_EQ(2, child.getChildByIndex(1).getFileLine());
+  EXPECT_EQ(14, child.getChildByIndex(1).getFileColumn());
+}
+
+TEST(SExpressionTest, testParseUnescapesStrings) {
+  QByteArray  content = "(root \"a\\\"b\\\\c\\nd\")";
+  SExpression s       = SExpression::parse(content, FilePath());
+  EXPECT_EQ("a\"b\\c\nd", s.getValueOfFirstChild<QString>());
+}
+
+TEST(SExpressionTest, testParseRawNewlineInString) {
+  QByteArray  content = "(root \"a\nb\" (child 1))";
+  SExpression s       = SExpression::parse(content, FilePath());
+  EXPECT_EQ("a\nb", s.getValueOfFirstChild<QString>());
+  EXPECT_EQ(2, s.getChildByPath("child").getFileLine());
+}
+
+TEST(SExpressionTest, testParseSkipsBomAndComments) {
+  QByteArray  content = "\xEF\xBB\xBF; comment\n(root ; another comment\n 1)";
+  SExpression s       = SExpression::parse(content, FilePath());
+  EXPECT_EQ(1, s.getChildren().count());
+  EXPECT_EQ(1, s.getValueOfFirstChild<int>());
+}
+
+TEST(SExpressionTest, testParseInternsShortTokens) {
+  QByteArray  content = "(root (vertex 0.0) (vertex 0.0))";
+  SExpression s       = SExpression::parse(content, FilePath());
+  const SExpression& v1 = s.getChildByIndex(0);
+  const SExpression& v2 = s.getChildByIndex(1);
+  EXPECT_EQ(v1.getName().constData(), v2.getName().constData());
+  EXPECT_EQ(v1.getChildByIndex(0).getStringOrToken().constData(),
+            v2.getChildByIndex(0).getStringOrToken().constData());
+}
+
+TEST(SExpressionTest, testMoveKeepsChildren) {
+  SExpression s = SExpression::createList("root");
+  s.appendChild("child", 42, false);
+  SExpression moved(std::move(s));
+  EXPECT_EQ(1, moved.getChildren().count());
+  EXPECT_EQ(42, moved.getValueByPath<int>("child"));
+}
+
+TEST(SExpressionTest, testParseErrorReportsPosition) {
+  QByteArray content = "(root\n  (child \"unterminated)\n)";
+  try {
+    SExpression::parse(content, FilePath());
+    FAIL() << "Exception not thrown";
+  } catch (const FileParseError& e) {
+    EXPECT_TRUE(e.getMsg().contains("Line,Column: 2,"))
+        << qPrintable(e.getMsg());
+  }
+}
+
+TEST(SExpressionTest, testParseInvalidInputThrows) {
+  QList<QByteArray> inputs = {"", "foo", "(root", "(a)(b)", "(\"a\")",
+                              "(a \"\\x\")"};
+  foreach (const QByteArray& input, inputs) {
+    EXPECT_THROW(SExpression::parse(input, FilePath()), FileParseError)
+        << input.constData();
+  }
+}
+
+TEST(SExpressionTest, testSerializeParseRoundTrip) {
+  SExpression root = SExpression::createList("root");
+  root.appendChild("name", QString("quote \" and\nnewline"), true);
+  root.appendChild("value", 1337, true);
+  SExpression parsed = SExpression::parse(root.toString(0), FilePath());
+  EXPECT_EQ("quote \" and\nnewline", parsed.getValueByPath<QString>("name"));
+  EXPECT_EQ(1337, parsed.getValueByPath<int>("value"));
+}
+
+TEST(SExpressionTest, testGetChildByPathReturnsFirstMatch) {
+  for (int count : {2, 100}) {  // without and with child index
+    SExpression s = SExpression::createList("root");
+    for (int i = 0; i < count; ++i) {
+      s.appendChild("child", i, true);
+    }
+    EXPECT_EQ(0, s.getValueByPath<int>("child")) << count;
+    s.appendChild("other", 42, true);  // appending must update the index
+    EXPECT_EQ(42, s.getValueByPath<int>("other")) << count;
+    EXPECT_FALSE(s.tryGetChildByPath("missing")) << count;
+    EXPECT_FALSE(s.tryGetChildByPath("child/missing")) << count;
+  }
+}
+
+TEST(SExpressionTest, testGetChildByPathOfLargeParsedLists) {
+  QByteArray content = "(root";
+  for (int i = 0; i < 100; ++i) {
+    content += QString(" (child %1) token").arg(i).toUtf8();
+  }
+  content += " (other 42))";
+  const SExpression s = SExpression::parse(content, FilePath());
+  EXPECT_EQ(0, s.getValueByPath<int>("child"));
+  EXPECT_EQ(42, s.getValueByPath<int>("other"));
+  EXPECT_FALSE(s.tryGetChildByPath("missing"));
+
+  // a large list without any list children
+  content = "(root" + QByteArray(" token").repeated(100) + ")";
+  EXPECT_FALSE(SExpression::parse(content, FilePath()).tryGetChildByPath("a"));
+
+  // removing line breaks changes the indices of the children
+  SExpression copy = s;
+  copy.appendLineBreak();
+  copy.appendChild("last", 1, true);
+  copy.removeLineBreaks();
+  EXPECT_EQ(0, copy.getValueByPath<int>("child"));
+  EXPECT_EQ(1, copy.getValueByPath<int>("last"));
+}
+
+TEST(SExpressionTest, testGetChildByNestedPath) {
+  QByteArray  content = "(root (a (x 1)) (b (y 2) (z (w 3))))";
+  SExpression s       = SExpression::parse(content, FilePath());
+  EXPECT_EQ(1, s.getValueByPath<int>("a/x"));
+  EXPECT_EQ(3, s.getValueByPath<int>("b/z/w"));
+  EXPECT_FALSE(s.tryGetChildByPath("a/y"));
+}
+
+TEST(SExpressionTest, testSerialize) {
+  SExpression root = SExpression::createList("root");
+  root.appendChild("a", 1, true);
+  root.appendList("b", true).appendChild(QString("\xC3\xA4\"\n"));
+  root.appendChild(SExpression::createToken("c"), false);
+  QByteArray expected = "(root\n (a 1)\n (b \"\xC3\xA4\\\"\\n\") c\n)";
+  EXPECT_EQ(QString::fromUtf8(expected), root.toString(0));
+  EXPECT_EQ(expected + "\n", root.toByteArray());
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  root.serialize(buffer);
+  EXPECT_EQ(expected + "\n", buffer.data());
+}
+
+TEST(SExpressionTest, testSerializeInvalidNodesThrows) {
+  EXPECT_THROW(SExpression::createToken("a b").toString(0), LogicError);
+  EXPECT_THROW(SExpression::createToken("").toString(0), LogicError);
+  EXPECT_THROW(SExpression::createList("Foo").toString(0), LogicError);
+  EXPECT_THROW(SExpression::createList("1a").toString(0), LogicError);
+}
+
+/**
+ * Micro-benchmark for the child lookup of large nodes: Looking up every child
+ * of a node by name must be O(children) in total thanks to the child index.
+ * The naive linear scan is measured as reference.
+ */
+TEST(SExpressionTest, testChildLookupBenchmark) {
+  const int   count = 10000;
+  SExpression s     = SExpression::createList("root");
+  for (int i = 0; i < count; ++i) {
+    s.appendChild(QString("child_%1").arg(i), i, true);
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < count; ++i) {
+    ASSERT_EQ(i, s.getValueByPath<int>(QString("child_%1").arg(i)));
+  }
+  qint64 indexedMs = timer.restart();
+  for (int i = 0; i < count; ++i) {
+    QString name = QString("child_%1").arg(i);
+    for (const SExpression& child : s.getChildren()) {
+      if (child.isList() && (child.getName() == name)) {
+        ASSERT_EQ(i, child.getValueOfFirstChild<int>());
+        break;
+      }
+    }
+  }
+  qint64 linearMs = timer.elapsed();
+  std::cout << "[          ] " << count << " lookups: indexed " << indexedMs
+            << " ms, linear scan " << linearMs << " ms" << std::endl;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
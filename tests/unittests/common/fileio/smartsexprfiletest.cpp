@@ -0,0 +1,122 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SmartSExprFileTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+  FilePath mFilePath;
+
+  SmartSExprFileTest() {
+    mTempDir  = FilePath::getRandomTempPath();
+    mFilePath = mTempDir.getPathTo("file.lp");
+  }
+
+  virtual ~SmartSExprFileTest() { QDir(mTempDir.toStr()).removeRecursively(); }
+
+  static SExpression createDocument(int value) {
+    SExpression doc = SExpression::createList("root");
+    doc.appendChild("value", value, true);
+    return doc;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SmartSExprFileTest, testSaveWritesNewFile) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  file->save(createDocument(1), true);
+  EXPECT_EQ(createDocument(1).toByteArray(), FileUtils::readFile(mFilePath));
+}
+
+TEST_F(SmartSExprFileTest, testSaveSkipsUnchangedContent) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  file->save(createDocument(1), true);
+  // Modify the file behind the back of SmartSExprFile to detect rewrites.
+  FileUtils::writeFile(mFilePath, "marker");
+  file->save(createDocument(1), true);
+  EXPECT_EQ(QByteArray("marker"), FileUtils::readFile(mFilePath));
+}
+
+TEST_F(SmartSExprFileTest, testSkippedSaveLeavesNoTemporaryFiles) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  file->save(createDocument(1), true);
+  file->save(createDocument(1), true);
+  EXPECT_EQ(QStringList{"file.lp"},
+            QDir(mTempDir.toStr()).entryList(QDir::Files | QDir::Hidden));
+}
+
+TEST_F(SmartSExprFileTest, testSaveWritesChangedContent) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  file->save(createDocument(1), true);
+  file->save(createDocument(2), true);
+  EXPECT_EQ(createDocument(2).toByteArray(), FileUtils::readFile(mFilePath));
+}
+
+TEST_F(SmartSExprFileTest, testSaveRewritesRemovedFile) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  file->save(createDocument(1), true);
+  FileUtils::removeFile(mFilePath);
+  file->save(createDocument(1), true);
+  EXPECT_EQ(createDocument(1).toByteArray(), FileUtils::readFile(mFilePath));
+}
+
+TEST_F(SmartSExprFileTest, testSaveSkipsUnchangedLoadedFile) {
+  FileUtils::writeFile(mFilePath, createDocument(1).toByteArray());
+  SmartSExprFile file(mFilePath, false, false);
+  SExpression    doc = file.parseFileAndBuildDomTree();
+  FileUtils::writeFile(mFilePath, "marker");
+  file.save(doc, true);
+  EXPECT_EQ(QByteArray("marker"), FileUtils::readFile(mFilePath));
+}
+
+TEST_F(SmartSExprFileTest, testBackupAndOriginalAreTrackedSeparately) {
+  QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
+  file->save(createDocument(1), false);  // backup only
+  file->save(createDocument(1), true);   // original must still be written
+  EXPECT_EQ(createDocument(1).toByteArray(), FileUtils::readFile(mFilePath));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
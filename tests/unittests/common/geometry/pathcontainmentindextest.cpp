@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/geometry/pathcontainmentindex.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PathContainmentIndexTest : public ::testing::Test {
+protected:
+  static QVector<Path> createPaths() noexcept {
+    QVector<Path> paths;
+    paths.append(Path::rect(Point(0, 0), Point(10000000, 5000000)));
+    paths.append(Path::circle(PositiveLength(8000000))
+                     .translated(Point(20000000, 0)));
+    paths.append(Path::octagon(PositiveLength(6000000), PositiveLength(9000000))
+                     .translated(Point(3000000, 2000000)));  // overlapping
+    paths.append(Path(QVector<Vertex>{
+        // U-shaped (concave) polygon
+        Vertex(Point(-20000000, -10000000)), Vertex(Point(-5000000, -10000000)),
+        Vertex(Point(-5000000, 5000000)), Vertex(Point(-8000000, 5000000)),
+        Vertex(Point(-8000000, -7000000)), Vertex(Point(-17000000, -7000000)),
+        Vertex(Point(-17000000, 5000000)), Vertex(Point(-20000000, 5000000)),
+        Vertex(Point(-20000000, -10000000))}));
+    return paths;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PathContainmentIndexTest, testEmpty) {
+  PathContainmentIndex index;
+  EXPECT_EQ(0, index.count());
+  EXPECT_TRUE(index.findPathsAt(Point(0, 0)).isEmpty());
+  EXPECT_FALSE(index.contains(0, Point(0, 0)));
+}
+
+TEST_F(PathContainmentIndexTest, testSetPathsReplacesOldPaths) {
+  PathContainmentIndex index(createPaths());
+  index.setPaths({Path::rect(Point(0, 0), Point(1000, 1000))});
+  EXPECT_EQ(1, index.count());
+  EXPECT_EQ(QVector<int>{0}, index.findPathsAt(Point(500, 500)));
+  EXPECT_TRUE(index.findPathsAt(Point(-10000000, -8000000)).isEmpty());
+}
+
+TEST_F(PathContainmentIndexTest, testCompareWithQPainterPath) {
+  QVector<Path>        paths = createPaths();
+  PathContainmentIndex index(paths);
+  ASSERT_EQ(paths.count(), index.count());
+  // the odd offsets avoid points exactly on the outlines
+  for (qint64 x = -25000123; x < 30000000; x += 370001) {
+    for (qint64 y = -15000077; y < 15000000; y += 290003) {
+      Point        pos(x, y);
+      QVector<int> expected;
+      bool         nearArc = false;
+      for (int i = 0; i < paths.count(); ++i) {
+        bool contained;
+        if (i == 1) {
+          // QPainterPath approximates arcs with bezier curves, thus checking
+          // the distance to the center is more accurate for the circle
+          qreal distance = (pos - Point(20000000, 0)).getLength().toNm();
+          contained      = (distance < 4000000);
+          nearArc        = (qAbs(distance - 4000000) < 10000);
+        } else {
+          contained =
+              paths.at(i).toQPainterPathPx().contains(pos.toPxQPointF());
+        }
+        if (contained) expected.append(i);
+        if (nearArc) continue;
+        EXPECT_EQ(contained, index.contains(i, pos)) << i << " " << x << " "
+                                                     << y;
+      }
+      if (nearArc) continue;
+      EXPECT_EQ(expected, index.findPathsAt(pos)) << x << " " << y;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,222 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/undocommand.h>
+#include <librepcb/common/undostack.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class UndoStackTest : public ::testing::Test {
+protected:
+  class Cmd final : public UndoCommand {
+  public:
+    Cmd(int& value, int newValue, qint64 payload) noexcept
+      : UndoCommand(QString::number(newValue)),
+        mValue(value),
+        mOldValue(value),
+        mNewValue(newValue),
+        mPayload(payload) {}
+    qint64 getMemoryUsage() const noexcept override {
+      return UndoCommand::getMemoryUsage() + mPayload;
+    }
+
+  private:
+    bool performExecute() override {
+      performRedo();
+      return true;
+    }
+    void performUndo() override { mValue = mOldValue; }
+    void performRedo() override { mValue = mNewValue; }
+
+    int&   mValue;
+    int    mOldValue;
+    int    mNewValue;
+    qint64 mPayload;
+  };
+
+  class VariableSizeCmd final : public UndoCommand {
+  public:
+    explicit VariableSizeCmd(const qint64& payload) noexcept
+      : UndoCommand("variable"), mPayload(payload) {}
+    qint64 getMemoryUsage() const noexcept override {
+      return UndoCommand::getMemoryUsage() + mPayload;
+    }
+
+  private:
+    bool performExecute() override { return true; }
+    void performUndo() override {}
+    void performRedo() override {}
+
+    const qint64& mPayload;
+  };
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(UndoStackTest, testMemoryUsage) {
+  int       value = 0;
+  UndoStack stack;
+  EXPECT_EQ(0, stack.getMemoryUsage());
+  stack.execCmd(new Cmd(value, 1, 1000));
+  stack.execCmd(new Cmd(value, 2, 2000));
+  EXPECT_GE(stack.getMemoryUsage(), 3000);
+  stack.undo();
+  stack.execCmd(new Cmd(value, 3, 10));  // deletes the redo command
+  EXPECT_GE(stack.getMemoryUsage(), 1010);
+  EXPECT_LT(stack.getMemoryUsage(), 2000);
+  stack.clear();
+  EXPECT_EQ(0, stack.getMemoryUsage());
+}
+
+TEST_F(UndoStackTest, testCommandGroupMemoryUsage) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new Cmd(value, 1, 1000));
+  qint64 usage = stack.getMemoryUsage();
+  stack.beginCmdGroup("group");
+  stack.appendToCmdGroup(new Cmd(value, 2, 5000));
+  stack.commitCmdGroup();
+  EXPECT_GE(stack.getMemoryUsage(), usage + 5000);
+  usage = stack.getMemoryUsage();
+  stack.beginCmdGroup("group");
+  stack.appendToCmdGroup(new Cmd(value, 3, 5000));
+  stack.abortCmdGroup();
+  EXPECT_EQ(usage, stack.getMemoryUsage());
+}
+
+TEST_F(UndoStackTest, testChangedCommandSizeIsNotReaccounted) {
+  int       value   = 0;
+  qint64    payload = 5000;
+  UndoStack stack;
+  stack.execCmd(new Cmd(value, 1, 1000));
+  qint64 usage = stack.getMemoryUsage();
+  stack.execCmd(new VariableSizeCmd(payload));
+  payload = 0;  // the command now reports a smaller size than accounted
+  stack.undo();
+  stack.execCmd(new Cmd(value, 2, 0));  // deletes the variable size command
+  EXPECT_LT(stack.getMemoryUsage(), usage + 1000);
+  stack.setMaxCommandCount(1);  // deletes the first command
+  EXPECT_LT(stack.getMemoryUsage(), 1000);
+  stack.clear();
+  EXPECT_EQ(0, stack.getMemoryUsage());
+}
+
+TEST_F(UndoStackTest, testMaxCommandCountDeletesOldestCommands) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setMaxCommandCount(3);
+  for (int i = 1; i <= 10; ++i) {
+    stack.execCmd(new Cmd(value, i, 0));
+  }
+  EXPECT_EQ(10, value);
+  for (int i = 0; i < 10; ++i) {
+    stack.undo();  // does nothing if undo is not possible anymore
+  }
+  EXPECT_EQ(7, value);
+  EXPECT_FALSE(stack.canUndo());
+  stack.redo();
+  EXPECT_EQ(8, value);
+}
+
+TEST_F(UndoStackTest, testCommandGroupIsCompactedOnCommit) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setMaxCommandCount(2);
+  stack.execCmd(new Cmd(value, 1, 0));
+  stack.execCmd(new Cmd(value, 2, 0));
+  stack.beginCmdGroup("group");  // must not delete any command yet
+  stack.abortCmdGroup();
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(0, value);
+  stack.redo();
+  stack.redo();
+  stack.beginCmdGroup("group");
+  stack.appendToCmdGroup(new Cmd(value, 3, 0));
+  stack.commitCmdGroup();  // deletes the oldest command
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(stack.canUndo());
+}
+
+TEST_F(UndoStackTest, testMaxMemoryUsageKeepsTopCommand) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setMaxMemoryUsage(10000);
+  stack.execCmd(new Cmd(value, 1, 4000));
+  stack.execCmd(new Cmd(value, 2, 4000));
+  stack.execCmd(new Cmd(value, 3, 4000));  // the first one must be deleted
+  EXPECT_LE(stack.getMemoryUsage(), 10000);
+  stack.execCmd(new Cmd(value, 4, 50000));  // too large, but must be kept
+  EXPECT_GE(stack.getMemoryUsage(), 50000);
+  stack.undo();
+  EXPECT_EQ(3, value);
+  EXPECT_FALSE(stack.canUndo());
+}
+
+TEST_F(UndoStackTest, testCompactionInvalidatesCleanState) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new Cmd(value, 1, 0));
+  stack.setClean();
+  stack.execCmd(new Cmd(value, 2, 0));
+  stack.execCmd(new Cmd(value, 3, 0));
+  stack.setMaxCommandCount(1);  // the clean state is no longer reachable
+  stack.undo();
+  EXPECT_EQ(2, value);
+  EXPECT_FALSE(stack.isClean());
+}
+
+TEST_F(UndoStackTest, testCompactionKeepsCleanState) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new Cmd(value, 1, 0));
+  stack.execCmd(new Cmd(value, 2, 0));
+  stack.setClean();
+  stack.execCmd(new Cmd(value, 3, 0));
+  stack.setMaxCommandCount(1);
+  EXPECT_FALSE(stack.isClean());
+  stack.undo();
+  EXPECT_EQ(2, value);
+  EXPECT_TRUE(stack.isClean());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,134 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/rtree.h>
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class RTreeTest : public ::testing::Test {
+protected:
+  static QList<int> sorted(QList<int> list) noexcept {
+    std::sort(list.begin(), list.end());
+    return list;
+  }
+
+  /// Reference implementation: linear search
+  static QList<int> findLinear(const QHash<int, QRectF>& items,
+                               const QRectF&             rect) noexcept {
+    QList<int> list;
+    for (auto it = items.constBegin(); it != items.constEnd(); ++it) {
+      if ((it->left() <= rect.right()) && (rect.left() <= it->right()) &&
+          (it->top() <= rect.bottom()) && (rect.top() <= it->bottom())) {
+        list.append(it.key());
+      }
+    }
+    return sorted(list);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(RTreeTest, testEmpty) {
+  RTree<int> tree;
+  EXPECT_TRUE(tree.isEmpty());
+  EXPECT_EQ(0, tree.count());
+  EXPECT_TRUE(tree.find(QPointF(0, 0)).isEmpty());
+  EXPECT_FALSE(tree.remove(42));
+}
+
+TEST_F(RTreeTest, testFindPointOnEdge) {
+  RTree<int> tree;
+  tree.insert(1, QRectF(0, 0, 10, 10));
+  tree.insert(2, QRectF(QPointF(5, 5), QSizeF(0, 0)));  // a single point
+  EXPECT_EQ(QList<int>({1}), tree.find(QPointF(10, 10)));
+  EXPECT_EQ(QList<int>({1, 2}), sorted(tree.find(QPointF(5, 5))));
+  EXPECT_EQ(QList<int>(), tree.find(QPointF(10.1, 5)));
+}
+
+TEST_F(RTreeTest, testInsertExistingValueUpdatesBounds) {
+  RTree<int> tree;
+  tree.insert(1, QRectF(0, 0, 1, 1));
+  tree.insert(1, QRectF(100, 100, 1, 1));
+  EXPECT_EQ(1, tree.count());
+  EXPECT_EQ(QRectF(100, 100, 1, 1), tree.getBounds(1));
+  EXPECT_TRUE(tree.find(QPointF(0.5, 0.5)).isEmpty());
+  EXPECT_EQ(QList<int>({1}), tree.find(QPointF(100.5, 100.5)));
+}
+
+TEST_F(RTreeTest, testCompareWithLinearSearch) {
+  qsrand(42);
+  RTree<int>         tree;
+  QHash<int, QRectF> items;
+  auto randomRect = []() {
+    return QRectF(qrand() % 1000, qrand() % 1000, qrand() % 20, qrand() % 20);
+  };
+
+  // insert many items to get a deep tree
+  for (int i = 0; i < 2000; ++i) {
+    QRectF rect = randomRect();
+    tree.insert(i, rect);
+    items.insert(i, rect);
+  }
+  // move some items and remove some others
+  for (int i = 0; i < 2000; i += 3) {
+    QRectF rect = randomRect();
+    tree.insert(i, rect);
+    items.insert(i, rect);
+  }
+  for (int i = 1; i < 2000; i += 4) {
+    EXPECT_TRUE(tree.remove(i));
+    items.remove(i);
+  }
+  EXPECT_EQ(items.count(), tree.count());
+
+  for (int i = 0; i < 200; ++i) {
+    QRectF rect = randomRect();
+    EXPECT_EQ(findLinear(items, rect), sorted(tree.find(rect)));
+  }
+
+  // remove all items
+  foreach (int value, items.keys()) { EXPECT_TRUE(tree.remove(value)); }
+  EXPECT_TRUE(tree.isEmpty());
+  EXPECT_TRUE(tree.find(QRectF(0, 0, 1000, 1000)).isEmpty());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -144,6 +144,17 @@ TEST_P(UuidTest, testOperatorComparisons) {
   }
 }
 
+TEST_P(UuidTest, testQHash) {
+  const UuidTestData& data = GetParam();
+
+  if (data.valid) {
+    Uuid uuid1 = Uuid::fromString(data.uuid);
+    Uuid uuid2 = Uuid::fromString(uuid1.toStr());
+    EXPECT_EQ(qHash(uuid1, 0), qHash(uuid2, 0));
+    EXPECT_EQ(qHash(uuid1, 42), qHash(uuid2, 42));
+  }
+}
+
 TEST(UuidTest, testCreateRandom) {
   for (int i = 0; i < 1000; i++) {
     Uuid uuid = Uuid::createRandom();
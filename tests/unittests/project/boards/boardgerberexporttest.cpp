@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardfabricationoutputsettings.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardGerberExportTest : public ::testing::Test {
+protected:
+  FilePath mOutputDir;
+
+  BoardGerberExportTest() {
+    mOutputDir = FilePath::getRandomTempPath().getPathTo("gerber output");
+  }
+
+  virtual ~BoardGerberExportTest() {
+    QDir(mOutputDir.getParentDir().toStr()).removeRecursively();
+  }
+
+  /// Exports all files and returns their content, without the creation date
+  static QList<QPair<QString, QByteArray>> exportFiles(
+      Board& board, const FilePath& dir, bool parallel) {
+    board.getFabricationOutputSettings().setOutputBasePath(dir.toStr() %
+                                                           "/board");
+    BoardGerberExport grbExport(board);
+    grbExport.exportAllLayers(parallel);  // can throw
+    QList<QPair<QString, QByteArray>> files;
+    foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
+      QList<QByteArray> lines = FileUtils::readFile(fp).split('\n');
+      for (int i = lines.count() - 1; i >= 0; --i) {
+        if (lines.at(i).contains("CreationDate") ||
+            lines.at(i).contains("Creation Date")) {
+          lines.removeAt(i);
+        }
+      }
+      files.append(qMakePair(fp.toRelative(dir), lines.join('\n')));
+    }
+    return files;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardGerberExportTest, testParallelExportEqualsSerialExport) {
+  FilePath projectFp(TEST_DATA_DIR
+                     "/unittests/librepcbproject/"
+                     "BoardPlaneFragmentsBuilderTest/test_project/"
+                     "test_project.lpp");
+  QScopedPointer<Project> project(new Project(projectFp, true, false));
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  QList<QPair<QString, QByteArray>> serialFiles =
+      exportFiles(*board, mOutputDir.getPathTo("serial"), false);
+  QList<QPair<QString, QByteArray>> parallelFiles =
+      exportFiles(*board, mOutputDir.getPathTo("parallel"), true);
+  ASSERT_FALSE(serialFiles.isEmpty());
+  ASSERT_EQ(serialFiles.count(), parallelFiles.count());
+  for (int i = 0; i < serialFiles.count(); ++i) {
+    EXPECT_EQ(serialFiles.at(i).first.toStdString(),
+              parallelFiles.at(i).first.toStdString());
+    EXPECT_EQ(serialFiles.at(i).second.toStdString(),
+              parallelFiles.at(i).second.toStdString());
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -103,6 +103,27 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expectedPlaneFragments, actualPlaneFragments);
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testRebuildWithoutChangesIsStable) {
+  FilePath testDataDir(
+      TEST_DATA_DIR
+      "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest");
+  FilePath projectFp = testDataDir.getPathTo("test_project/test_project.lpp");
+  QScopedPointer<Project> project(new Project(projectFp, true, false));
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  // clear all planes, the rebuild must then restore the same fragments
+  QMap<Uuid, QVector<Path>> fragments;
+  foreach (BI_Plane* plane, board->getPlanes()) {
+    fragments.insert(plane->getUuid(), plane->getFragments());
+    plane->clear();
+  }
+  board->rebuildAllPlanes();
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    EXPECT_EQ(fragments.value(plane->getUuid()), plane->getFragments());
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,217 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardairwiresbuilder.h>
+#include <librepcb/project/boards/items/bi_airwire.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardTest : public ::testing::Test {
+protected:
+  FilePath mProjectFp;
+
+  BoardTest() {
+    mProjectFp = FilePath(TEST_DATA_DIR
+                          "/unittests/librepcbproject/"
+                          "BoardPlaneFragmentsBuilderTest/test_project/"
+                          "test_project.lpp");
+  }
+
+  static QString airWireToString(const NetSignal& netsignal, const Point& p1,
+                                 const Point& p2) {
+    return QString("%1: (%2 %3) (%4 %5)")
+        .arg(netsignal.getUuid().toStr(), p1.getX().toNmString(),
+             p1.getY().toNmString(), p2.getX().toNmString(),
+             p2.getY().toNmString());
+  }
+
+  /// Returns the airwires currently added to the board
+  static QStringList getAirWires(const Board& board) {
+    QStringList airwires;
+    foreach (const BI_AirWire* airWire, board.getAirWires()) {
+      airwires.append(airWireToString(airWire->getNetSignal(),
+                                      airWire->getP1(), airWire->getP2()));
+    }
+    airwires.sort();
+    return airwires;
+  }
+
+  /// Calculates the airwires of all nets from scratch
+  static QStringList calcAirWires(const Board& board) {
+    QStringList airwires;
+    foreach (const NetSignal* netsignal,
+             board.getProject().getCircuit().getNetSignals()) {
+      BoardAirWiresBuilder builder(board, *netsignal);
+      foreach (const auto& points, builder.buildAirWires()) {
+        airwires.append(
+            airWireToString(*netsignal, points.first, points.second));
+      }
+    }
+    airwires.sort();
+    return airwires;
+  }
+
+  static void waitForAirWiresUpdated(Board& board) {
+    QEventLoop loop;
+    QObject::connect(&board, &Board::airWiresUpdated, &loop,
+                     &QEventLoop::quit);
+    QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+    loop.exec();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardTest, testIncrementalAirWiresEqualFullRebuild) {
+  QScopedPointer<Project> project(new Project(mProjectFp, true, false));
+  Board*                  board = project->getBoards().first();
+  EXPECT_EQ(calcAirWires(*board), getAirWires(*board));
+
+  // Remove all net segments one by one and add them again. After each step,
+  // the incrementally updated airwires must be equal to a full rebuild, and
+  // the airwire items of other nets must be kept.
+  QList<BI_NetSegment*> segments = board->getNetSegments();
+  ASSERT_FALSE(segments.isEmpty());
+  for (int i = 0; i < 2 * segments.count(); ++i) {
+    BI_NetSegment* segment = segments.at(i % segments.count());
+    QMultiHash<NetSignal*, BI_AirWire*> oldAirWires = board->getAirWires();
+    if (i < segments.count()) {
+      board->removeNetSegment(*segment);
+    } else {
+      board->addNetSegment(*segment);
+    }
+    board->triggerAirWiresRebuild();
+    EXPECT_EQ(calcAirWires(*board), getAirWires(*board));
+    for (auto it = oldAirWires.begin(); it != oldAirWires.end(); ++it) {
+      if (it.key() != &segment->getNetSignal()) {
+        EXPECT_TRUE(board->getAirWires().contains(it.key(), it.value()));
+      }
+    }
+  }
+
+  // rebuilding without any modification must reuse all airwire items
+  QMultiHash<NetSignal*, BI_AirWire*> airWires = board->getAirWires();
+  board->forceAirWiresRebuild();
+  EXPECT_EQ(airWires.values().toSet(), board->getAirWires().values().toSet());
+  EXPECT_EQ(calcAirWires(*board), getAirWires(*board));
+}
+
+TEST_F(BoardTest, testAsyncAirWiresRequestsAreCoalesced) {
+  QScopedPointer<Project> project(new Project(mProjectFp, true, false));
+  Board*                  board = project->getBoards().first();
+  ASSERT_FALSE(board->getNetSegments().isEmpty());
+  BI_NetSegment* segment   = board->getNetSegments().first();
+  NetSignal*     netsignal = &segment->getNetSignal();
+  int            updates   = 0;
+  QObject        context;
+  QObject::connect(board, &Board::airWiresUpdated, &context,
+                   [&](NetSignal* net) {
+                     if (net == netsignal) ++updates;
+                   });
+
+  // many requests in a row must lead to only one calculation
+  for (int i = 0; i < 5; ++i) {
+    board->removeNetSegment(*segment);
+    board->triggerAirWiresRebuildAsync();
+    board->addNetSegment(*segment);
+    board->triggerAirWiresRebuildAsync();
+  }
+  board->removeNetSegment(*segment);
+  board->triggerAirWiresRebuildAsync();
+  EXPECT_EQ(0, updates);
+  waitForAirWiresUpdated(*board);
+  QThreadPool::globalInstance()->waitForDone();
+  QCoreApplication::processEvents();  // no further results must be applied
+  EXPECT_EQ(1, updates);
+  EXPECT_EQ(calcAirWires(*board), getAirWires(*board));
+
+  // restore the board to let the project clean up the net segment
+  board->addNetSegment(*segment);
+  board->triggerAirWiresRebuild();
+}
+
+TEST_F(BoardTest, testOutdatedAsyncAirWiresAreDiscarded) {
+  QScopedPointer<Project> project(new Project(mProjectFp, true, false));
+  Board*                  board = project->getBoards().first();
+  ASSERT_FALSE(board->getNetSegments().isEmpty());
+  BI_NetSegment* segment = board->getNetSegments().first();
+
+  // block the thread pool to keep the airwires job pending
+  QThreadPool* pool           = QThreadPool::globalInstance();
+  const int    maxThreadCount = pool->maxThreadCount();
+  pool->setMaxThreadCount(1);
+  QSemaphore    semaphore;
+  QFuture<void> blocker =
+      QtConcurrent::run([&semaphore]() { semaphore.acquire(); });
+
+  // start an asynchronous rebuild without the net segment
+  board->removeNetSegment(*segment);
+  board->triggerAirWiresRebuildAsync();
+  QCoreApplication::processEvents();  // starts the job
+
+  // a synchronous rebuild with the net segment makes the job outdated
+  board->addNetSegment(*segment);
+  board->triggerAirWiresRebuild();
+  QStringList expected = calcAirWires(*board);
+  EXPECT_EQ(expected, getAirWires(*board));
+
+  // the result of the outdated job must not be applied
+  int     updates = 0;
+  QObject context;
+  QObject::connect(board, &Board::airWiresUpdated, &context,
+                   [&](NetSignal*) { ++updates; });
+  semaphore.release();
+  blocker.waitForFinished();
+  pool->waitForDone();
+  pool->setMaxThreadCount(maxThreadCount);
+  QCoreApplication::processEvents();  // delivers the job result
+  EXPECT_EQ(0, updates);
+  EXPECT_EQ(expected, getAirWires(*board));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
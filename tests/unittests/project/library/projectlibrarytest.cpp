@@ -117,6 +117,24 @@ TEST_F(ProjectLibraryTest, testLoadSymbol) {
             mExistingSymbolFile.size());  // not upgraded
 }
 
+TEST_F(ProjectLibraryTest, testLoadManySymbols) {
+  QSet<Uuid> uuids;
+  for (int i = 0; i < 50; ++i) {
+    library::Symbol sym(Uuid::createRandom(), Version::fromString("1"), "",
+                        ElementName(QString("Symbol %1").arg(i)), "", "");
+    sym.saveIntoParentDirectory(mLibDir.getPathTo("sym"));
+    uuids.insert(sym.getUuid());
+  }
+  ProjectLibrary lib(mLibDir, false, false);
+  EXPECT_EQ(51, lib.getSymbols().count());
+  foreach (const Uuid& uuid, uuids) {
+    library::Symbol* sym = lib.getSymbol(uuid);
+    ASSERT_TRUE(sym);
+    EXPECT_EQ(uuid, sym->getUuid());
+    EXPECT_EQ(QThread::currentThread(), sym->thread());
+  }
+}
+
 TEST_F(ProjectLibraryTest, testAddSymbol) {
   {
     ProjectLibrary lib(mLibDir, false, false);
@@ -412,6 +430,27 @@ TEST_F(ProjectLibraryTest,
   EXPECT_EQ(copyName, symbol.getNames().getDefaultValue());
 }
 
+TEST_F(ProjectLibraryTest,
+       testRemoveSymbol_SaveToOriginal_AddSymbol_SaveToOriginal) {
+  {
+    ProjectLibrary   lib(mLibDir, false, false);
+    library::Symbol* sym = getFirstSymbol(lib);
+    EXPECT_EQ(mLibDir.getPathTo("sym").getPathTo(sym->getUuid().toStr()),
+              sym->getFilePath());  // loaded without copying
+
+    lib.removeSymbol(*sym);
+    saveToOriginal(lib);
+    EXPECT_FALSE(mExistingSymbolFile.exists());
+    EXPECT_NE(mLibDir.getPathTo("sym").getPathTo(sym->getUuid().toStr()),
+              sym->getFilePath());  // copied before removing the directory
+
+    lib.addSymbol(*sym);  // e.g. undo the removal
+    saveToOriginal(lib);
+    EXPECT_TRUE(mExistingSymbolFile.exists());
+  }
+  EXPECT_TRUE(mExistingSymbolFile.exists());
+}
+
 TEST_F(ProjectLibraryTest, testSavingToExistingEmptyDirectory) {
   ProjectLibrary lib(mLibDir, false, false);
 
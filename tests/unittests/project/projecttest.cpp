@@ -21,8 +21,10 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/project/boards/board.h>
 #include <librepcb/project/metadata/projectmetadata.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/schematics/schematic.h>
 
 #include <QtCore>
 
@@ -131,6 +133,30 @@ TEST_F(ProjectTest, testSave) {
   project.reset(new Project(mProjectFile, false, false));
 }
 
+TEST_F(ProjectTest, testSaveAndOpenSchematicAndBoard) {
+  // create new project with a schematic and a board
+  QScopedPointer<Project> project(Project::create(mProjectFile));
+  Schematic* schematic = project->createSchematic(ElementName("Sheet 1"));
+  project->addSchematic(*schematic);
+  Board* board = project->createBoard(ElementName("Board 1"));
+  project->addBoard(*board);
+  Uuid schematicUuid = schematic->getUuid();
+  Uuid boardUuid     = board->getUuid();
+  project->save(true);
+
+  // close and re-open project
+  project.reset();
+  project.reset(new Project(mProjectFile, false, false));
+  ASSERT_EQ(1, project->getSchematics().count());
+  ASSERT_EQ(1, project->getBoards().count());
+  schematic = project->getSchematics().first();
+  board     = project->getBoards().first();
+  EXPECT_EQ(schematicUuid, schematic->getUuid());
+  EXPECT_EQ(ElementName("Sheet 1"), schematic->getName());
+  EXPECT_EQ(boardUuid, board->getUuid());
+  EXPECT_EQ(ElementName("Board 1"), board->getName());
+}
+
 TEST_F(ProjectTest, testIfLastModifiedDateTimeIsUpdatedOnSave) {
   // create new project
   QScopedPointer<Project> project(Project::create(mProjectFile));
@@ -26,7 +26,6 @@ LIBS += \
     -llibrepcbproject \
     -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
     -llibrepcbcommon \     # Another order could end up in "undefined reference" errors!
-    -lsexpresso \
     -lclipper \
     -lparseagle -lquazip -lz
 
@@ -47,7 +46,6 @@ DEPENDPATH += \
     ../../libs/librepcb/common \
     ../../libs/parseagle \
     ../../libs/quazip \
-    ../../libs/sexpresso \
     ../../libs/clipper \
 
 PRE_TARGETDEPS += \
@@ -58,17 +56,23 @@ PRE_TARGETDEPS += \
     $${DESTDIR}/liblibrepcblibrary.a \
     $${DESTDIR}/liblibrepcbcommon.a \
     $${DESTDIR}/libquazip.a \
-    $${DESTDIR}/libsexpresso.a \
     $${DESTDIR}/libclipper.a \
 
 SOURCES += \
     common/angletest.cpp \
     common/applicationtest.cpp \
     common/attributes/attributesubstitutortest.cpp \
+    common/cam/drillpathoptimizertest.cpp \
+    common/cam/gerberaperturelisttest.cpp \
+    common/cam/gerbergeneratortest.cpp \
     common/directorylocktest.cpp \
     common/filedownloadtest.cpp \
+    common/fileio/asyncsexprfilewritertest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
+    common/fileio/sexpressiontest.cpp \
+    common/fileio/smartsexprfiletest.cpp \
     common/filepathtest.cpp \
+    common/geometry/pathcontainmentindextest.cpp \
     common/lengthsnaptest.cpp \
     common/lengthtest.cpp \
     common/networkrequesttest.cpp \
@@ -78,6 +82,8 @@ SOURCES += \
     common/sqlitedatabasetest.cpp \
     common/systeminfotest.cpp \
     common/toolboxtest.cpp \
+    common/undostacktest.cpp \
+    common/utils/rtreetest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     eagleimport/deviceconvertertest.cpp \
@@ -87,9 +93,12 @@ SOURCES += \
     library/componentsymbolvariantitemtest.cpp \
     library/librarybaseelementtest.cpp \
     main.cpp \
+    project/boards/boardgerberexporttest.cpp \
     project/boards/boardplanefragmentsbuildertest.cpp \
+    project/boards/boardtest.cpp \
     project/library/projectlibrarytest.cpp \
     project/projecttest.cpp \
+    workspace/library/workspacelibrarydbtest.cpp \
     workspace/workspacetest.cpp \
 
 HEADERS += \
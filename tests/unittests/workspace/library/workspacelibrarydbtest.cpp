@@ -0,0 +1,227 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/library.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryDbTest : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+
+  WorkspaceLibraryDbTest() {
+    mWsDir = FilePath::getRandomTempPath().getPathTo("test workspace dir");
+    Workspace::createNewWorkspace(mWsDir);
+  }
+
+  virtual ~WorkspaceLibraryDbTest() {
+    QDir(mWsDir.getParentDir().toStr()).removeRecursively();
+  }
+
+  static Uuid createComponent(library::Library& lib, const QString& name) {
+    library::Component cmp(Uuid::createRandom(), Version::fromString("1"), "",
+                           ElementName(name), "", "");
+    cmp.saveIntoParentDirectory(lib.getElementsDirectory<library::Component>());
+    library::Device dev(Uuid::createRandom(), Version::fromString("1"), "",
+                        ElementName(name), "", "", cmp.getUuid(),
+                        Uuid::createRandom());
+    dev.saveIntoParentDirectory(lib.getElementsDirectory<library::Device>());
+    return cmp.getUuid();
+  }
+
+  static QHash<Uuid, int> getComponentRowIds(const WorkspaceLibraryDb& db) {
+    QHash<Uuid, int> ids;
+    SQLiteDatabase   sqlite(db.getFilePath());
+
+    QSqlQuery query = sqlite.prepareQuery("SELECT id, uuid FROM components");
+    sqlite.exec(query);
+    while (query.next()) {
+      ids.insert(Uuid::fromString(query.value(1).toString()),
+                 query.value(0).toInt());
+    }
+    return ids;
+  }
+
+  static QStringList dumpDatabase(const FilePath& fp) {
+    QStringList    rows;
+    SQLiteDatabase sqlite(fp);
+
+    QSqlQuery tables = sqlite.prepareQuery(
+        "SELECT name FROM sqlite_master WHERE type = 'table' "
+        "AND name NOT LIKE '%_fts%' ORDER BY name");
+    sqlite.exec(tables);
+    while (tables.next()) {
+      QString   table = tables.value(0).toString();
+      QSqlQuery query =
+          sqlite.prepareQuery("SELECT * FROM " % table % " ORDER BY rowid");
+      sqlite.exec(query);
+      while (query.next()) {
+        QStringList values(table);
+        for (int i = 0; i < query.record().count(); ++i) {
+          values.append(query.value(i).toString());
+        }
+        rows.append(values.join("|"));
+      }
+    }
+    return rows;
+  }
+
+  static void rescanAndWait(WorkspaceLibraryDb& db) {
+    QEventLoop loop;
+    QObject::connect(&db, &WorkspaceLibraryDb::scanFinished, &loop,
+                     &QEventLoop::quit);
+    db.startLibraryRescan();
+    loop.exec();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testSearchComponentByWordPrefix) {
+  Workspace        ws(mWsDir);
+  library::Library lib(Uuid::createRandom(), Version::fromString("1"), "",
+                       ElementName("Test Library"), "", "");
+  lib.saveTo(ws.getLocalLibrariesPath().getPathTo("Test.lplib"));
+  Uuid uuid = createComponent(lib, "Voltage Regulator");
+  createComponent(lib, "Resistor");
+  rescanAndWait(ws.getLibraryDb());
+
+  EXPECT_EQ(QList<Uuid>{uuid},
+            ws.getLibraryDb().getComponentsBySearchKeyword("regul"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchComponentBySubstring) {
+  Workspace        ws(mWsDir);
+  library::Library lib(Uuid::createRandom(), Version::fromString("1"), "",
+                       ElementName("Test Library"), "", "");
+  lib.saveTo(ws.getLocalLibrariesPath().getPathTo("Test.lplib"));
+  Uuid uuid = createComponent(lib, "NE555");
+  createComponent(lib, "LM7805");
+  rescanAndWait(ws.getLibraryDb());
+
+  // a match in the middle of a word must be found too
+  EXPECT_EQ(QList<Uuid>{uuid},
+            ws.getLibraryDb().getComponentsBySearchKeyword("555"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testRescanUpdatesOnlyModifiedElements) {
+  Workspace        ws(mWsDir);
+  library::Library lib(Uuid::createRandom(), Version::fromString("1"), "",
+                       ElementName("Test Library"), "", "");
+  lib.saveTo(ws.getLocalLibrariesPath().getPathTo("Test.lplib"));
+  Uuid unchanged = createComponent(lib, "Unchanged");
+  Uuid modified  = createComponent(lib, "Modified");
+  Uuid removed   = createComponent(lib, "Removed");
+  WorkspaceLibraryDb& db = ws.getLibraryDb();
+  rescanAndWait(db);
+  QHash<Uuid, int> ids = getComponentRowIds(db);
+  ASSERT_EQ(3, ids.count());
+
+  // modify one element and remove another one
+  FilePath modifiedDir = db.getLatestComponent(modified);
+  {
+    library::Component cmp(modifiedDir, false);
+    cmp.setNames(LocalizedNameMap(ElementName("Modified Component")));
+    cmp.save();
+  }
+  FileUtils::removeDirRecursively(db.getLatestComponent(removed));
+  rescanAndWait(db);
+
+  // the unchanged element must not be parsed and inserted again
+  QHash<Uuid, int> newIds = getComponentRowIds(db);
+  EXPECT_EQ(2, newIds.count());
+  EXPECT_EQ(ids.value(unchanged), newIds.value(unchanged));
+  EXPECT_TRUE(newIds.contains(modified));
+  EXPECT_NE(ids.value(modified), newIds.value(modified));
+  EXPECT_FALSE(newIds.contains(removed));
+  QString name;
+  db.getElementTranslations<library::Component>(modifiedDir, {}, &name);
+  EXPECT_EQ("Modified Component", name.toStdString());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testParallelScanEqualsSerialScan) {
+  FilePath dbFilePath;
+  {
+    Workspace        ws(mWsDir);
+    library::Library lib(Uuid::createRandom(), Version::fromString("1"), "",
+                         ElementName("Test Library"), "", "");
+    lib.saveTo(ws.getLocalLibrariesPath().getPathTo("Test.lplib"));
+    for (int i = 0; i < 50; ++i) {
+      createComponent(lib, QString("Component %1").arg(i));
+    }
+    dbFilePath = ws.getLibraryDb().getFilePath();
+  }
+
+  // scan with only one worker thread
+  QStringList serialRows;
+  const int   maxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(1);
+  {
+    Workspace ws(mWsDir);
+    rescanAndWait(ws.getLibraryDb());
+    serialRows = dumpDatabase(dbFilePath);
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+  ASSERT_TRUE(QFile::remove(dbFilePath.toStr()));
+
+  // scan again from scratch with all worker threads
+  QStringList parallelRows;
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(maxThreadCount, 4));
+  {
+    Workspace ws(mWsDir);
+    rescanAndWait(ws.getLibraryDb());
+    parallelRows = dumpDatabase(dbFilePath);
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+
+  EXPECT_GT(serialRows.count(), 100);
+  EXPECT_EQ(serialRows.join("\n").toStdString(),
+            parallelRows.join("\n").toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb